@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/Arena.cpp
+ *
+ * Bump allocator for short-lived allocations that are all released at once
+ */
+
+#include <base/Arena.h>
+
+void* Arena::AllocChunk(size_t size, size_t align)
+{
+    // worst-case size including alignment of the block inside the chunk
+    size_t required = size + align - 1;
+    ArenaChunk* chunk;
+    if (required <= ChunkPayload)
+    {
+        if constexpr (MemPoolSize<ARENA_CHUNK_SIZE>())
+        {
+            chunk = (ArenaChunk*)MemPoolAlloc<ARENA_CHUNK_SIZE>();
+        }
+        else
+        {
+            // chunks larger than the extended pools are allocated directly
+            chunk = (ArenaChunk*)malloc(ChunkSize);
+        }
+        if (!chunk)
+        {
+            return NULL;
+        }
+        chunk->size = ChunkPayload;
+    }
+    else
+    {
+        // oversized allocations get a dedicated chunk
+        chunk = (ArenaChunk*)malloc(sizeof(ArenaChunk) + required);
+        if (!chunk)
+        {
+            return NULL;
+        }
+        chunk->size = required;
+    }
+
+    chunk->next = chunks;
+    chunks = chunk;
+    p = chunk->data;
+    e = chunk->data + chunk->size;
+
+    auto a = (char*)((uintptr_t(p) + align - 1) & ~(align - 1));
+    p = a + size;
+    return a;
+}
+
+void Arena::FreeChunk(ArenaChunk* chunk)
+{
+    if (MemPoolSize<ARENA_CHUNK_SIZE>() && chunk->size == ChunkPayload)
+    {
+        MemPoolFree<ARENA_CHUNK_SIZE>(chunk);
+    }
+    else
+    {
+        free(chunk);
+    }
+}
+
+void Arena::Rewind(Checkpoint mark)
+{
+    while (chunks != mark.chunk)
+    {
+        ASSERT(chunks);
+        auto chunk = chunks;
+        chunks = chunk->next;
+        FreeChunk(chunk);
+    }
+
+    if ((p = mark.p))
+    {
+        e = chunks->data + chunks->size;
+    }
+    else
+    {
+        e = NULL;
+    }
+}
+
+void Arena::Reset()
+{
+    auto first = chunks;
+    if (!first)
+    {
+        return;
+    }
+
+    while (first->next)
+    {
+        first = first->next;
+    }
+
+    if (first->size != ChunkPayload)
+    {
+        // the oldest chunk is not reusable
+        Release();
+        return;
+    }
+
+    // rewind to the very beginning of the oldest chunk
+    Rewind({ first, first->data });
+}
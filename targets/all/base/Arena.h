@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/Arena.h
+ *
+ * Bump allocator for short-lived allocations that are all released at once
+ */
+
+#pragma once
+
+#include <base/base.h>
+#include <base/MemPool.h>
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef ARENA_CHUNK_SIZE
+// size of regular arena chunks (including header), allocated from MemPool if one serves this size
+#define ARENA_CHUNK_SIZE    512
+#endif
+
+struct ArenaChunk
+{
+    ArenaChunk* next;   //!< Previously allocated chunk
+    size_t size;        //!< Usable size of the chunk
+    char data[];
+};
+
+/*!
+ * Chunk-based bump allocator
+ *
+ * Memory is carved sequentially from chunks allocated from MemPool
+ * (or directly using malloc for allocations that do not fit a regular chunk,
+ * or when ARENA_CHUNK_SIZE exceeds MEMPOOL_EXT_MAX_SIZE)
+ * and released all at once using @ref Reset, @ref Rewind or when the Arena
+ * is destroyed. Destructors of objects allocated from the Arena are never
+ * called.
+ *
+ * The Arena can be declared as a variable in an async_def frame, in which case
+ * the memory is carried across awaits and released when the async function
+ * completes, including when it ends with an exception:
+ *
+ * @code
+ * async(HandleRequest, io::PipeReader r)
+ * async_def(Arena arena)
+ * {
+ *   auto hdr = f.arena.New<Header>();
+ *   ...
+ * }
+ * async_end
+ * @endcode
+ */
+class Arena
+{
+public:
+    //! Position in the Arena that can be returned to using @ref Rewind
+    struct Checkpoint
+    {
+        ArenaChunk* chunk;
+        char* p;
+    };
+
+    //! Releases all memory allocated after the position where the scope was entered when it is destroyed
+    class Scope
+    {
+    public:
+        constexpr Scope() : arena(NULL), mark{} {}
+        Scope(Arena& arena) : arena(&arena), mark(arena.Mark()) {}
+        ~Scope() { Leave(); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator =(const Scope&) = delete;
+
+        //! Enters the scope, useful when the Scope is declared as an async_def frame variable
+        void Enter(Arena& arena) { Leave(); this->arena = &arena; mark = arena.Mark(); }
+        //! Leaves the scope, releasing all memory allocated since it was entered
+        void Leave() { if (arena) { arena->Rewind(mark); arena = NULL; } }
+
+    private:
+        Arena* arena;
+        Checkpoint mark;
+    };
+
+    constexpr Arena() {}
+    ~Arena() { Release(); }
+
+    Arena(const Arena&) = delete;
+    Arena& operator =(const Arena&) = delete;
+
+    //! Allocates a block of memory with the specified alignment, the contents are undefined
+    void* Alloc(size_t size, size_t align = sizeof(intptr_t))
+    {
+        auto a = (char*)((uintptr_t(p) + align - 1) & ~(align - 1));
+        if (p && a + size <= e)
+        {
+            p = a + size;
+            return a;
+        }
+        return AllocChunk(size, align);
+    }
+
+    //! Allocates and constructs an object
+    template<typename T, typename... Args> T* New(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Destructors of objects allocated in an Arena are never called");
+        auto mem = Alloc(sizeof(T), alignof(T));
+        return mem ? new(mem) T(std::forward<Args>(args)...) : NULL;
+    }
+
+    //! Allocates an array of value-initialized objects
+    template<typename T> T* NewArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "Destructors of objects allocated in an Arena are never called");
+        auto mem = Alloc(sizeof(T) * count, alignof(T));
+        return mem ? new(mem) T[count]() : NULL;
+    }
+
+    //! Gets the current position in the Arena
+    Checkpoint Mark() const { return { chunks, p }; }
+    //! Releases everything allocated after the specified position
+    void Rewind(Checkpoint mark);
+    //! Releases all allocations, keeping the first regular chunk for reuse
+    void Reset();
+    //! Releases all allocations and all the memory held by the Arena
+    void Release() { Rewind({}); }
+
+private:
+    ArenaChunk* chunks = NULL;  //!< Most recently allocated chunk, linked to the previous ones
+    char* p = NULL;             //!< Next free byte in the current chunk
+    char* e = NULL;             //!< End of the current chunk
+
+    enum
+    {
+        ChunkSize = MemPoolSize<ARENA_CHUNK_SIZE>() ? MemPoolSize<ARENA_CHUNK_SIZE>() : ARENA_CHUNK_SIZE,
+        ChunkPayload = ChunkSize - sizeof(ArenaChunk),
+    };
+
+    void* AllocChunk(size_t size, size_t align);
+    static void FreeChunk(ArenaChunk* chunk);
+};
@@ -12,6 +12,16 @@
 
 #include <base/alloc_trace.h>
 
+#if MEMPOOL_STATS
+MemPool* MemPool::s_first;
+
+#define MEMPOOL_STATS_ALLOC()   ({ if (++allocs - frees > peak) { peak = allocs - frees; } })
+#define MEMPOOL_STATS_FREE()    ({ frees++; })
+#else
+#define MEMPOOL_STATS_ALLOC()
+#define MEMPOOL_STATS_FREE()
+#endif
+
 // inline helper for zeroing aligned memory
 // note that it is MANDATORY for size to be non-zero and a multiple of natural pointer size (intptr_t)
 ALWAYS_INLINE static void inline_memzero(void* ptr, size_t size)
@@ -29,6 +39,7 @@ void* MemPool::Alloc()
 #if MEMPOOL_DEBUG_PERIODIC_DUMP
     cnt++;
 #endif
+    MEMPOOL_STATS_ALLOC();
     auto res = free;
     if (res)
     {
@@ -47,6 +58,7 @@ void* MemPool::AllocDynamic()
 #if MEMPOOL_DEBUG_PERIODIC_DUMP
     cnt++;
 #endif
+    MEMPOOL_STATS_ALLOC();
     auto res = free;
     if (res)
     {
@@ -69,11 +81,19 @@ void* MemPool::AllocNewDynamic()
 
 void* MemPool::AllocNew()
 {
+#if MEMPOOL_STATS
+    if (!refills++)
+    {
+        // register the pool when it's used for the first time
+        next = s_first;
+        s_first = this;
+    }
+#endif
     // simply allocate the required memory, it will go back into the pool once freed
 #if HAS_MALLOC_ONCE
     void* mem = (char*)malloc_once(ALLOC_TRACE_OVERHEAD + size) + ALLOC_TRACE_OVERHEAD;
 #else
-    void* mem = malloc(size);
+    void* mem = (char*)malloc(ALLOC_TRACE_OVERHEAD + size) + ALLOC_TRACE_OVERHEAD;
 #endif
     inline_memzero(mem, size);
     return mem;
@@ -91,6 +111,7 @@ void** MemPool::AllocLarge(size_t size)
 void MemPool::Free(void* mem)
 {
     __trace_free(mem);
+    MEMPOOL_STATS_FREE();
 #if MEMPOOL_DEBUG_PERIODIC_DUMP
     cnt--;
     if (MONO_CLOCKS - lastDump >= MONO_FREQUENCY)
@@ -117,3 +138,38 @@ void MemPoolFreeDynamic(void* mem)
         free(ptr);
 #endif
 }
+
+#if MEMPOOL_STATS
+int MemPool::DumpJson(format_output output, void* context)
+{
+    int res = 0;
+    for (auto pool = First(); pool; pool = pool->Next())
+    {
+        auto s = pool->Stats();
+        res += format(output, context, "%c{\"size\":%u,\"live\":%u,\"free\":%u,\"peak\":%u,\"allocs\":%u,\"frees\":%u,\"refills\":%u}",
+            res ? ',' : '[', s.size, s.live, s.free, s.peak, s.allocs, s.frees, s.refills);
+    }
+    if (!res)
+    {
+        output(context, '[');
+        res++;
+    }
+    output(context, ']');
+    return res + 1;
+}
+
+size_t MemPool::DumpBinary(void* buffer, size_t length)
+{
+    size_t res = 0;
+    for (auto pool = First(); pool; pool = pool->Next())
+    {
+        if (res + sizeof(MemPoolStats) <= length)
+        {
+            auto s = pool->Stats();
+            memcpy((char*)buffer + res, &s, sizeof(s));
+        }
+        res += sizeof(MemPoolStats);
+    }
+    return res;
+}
+#endif
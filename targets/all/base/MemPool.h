@@ -17,7 +17,7 @@
 #define MEMPOOL_MIN_SIZE        (2 * sizeof(intptr_t))
 
 #ifndef MEMPOOL_MAX_SIZE
-// maximum pool size - larger chunks are malloc'd directly
+// maximum size of pools spaced by MEMPOOL_GRANULARITY - larger chunks use extended pools
 #define MEMPOOL_MAX_SIZE        (32 * sizeof(intptr_t))
 #endif
 
@@ -25,6 +25,40 @@
 #define MEMPOOL_GRANULARITY     (4 * sizeof(intptr_t))
 #endif
 
+#ifndef MEMPOOL_EXT_MAX_SIZE
+// maximum extended pool size - chunks between MEMPOOL_MAX_SIZE and this size
+// are allocated from pools with geometrically growing sizes, larger chunks
+// are malloc'd directly; set to MEMPOOL_MAX_SIZE to disable extended pools
+#define MEMPOOL_EXT_MAX_SIZE    4096
+#endif
+
+#ifndef MEMPOOL_EXT_STEPS
+// number of extended pool sizes for each doubling of the chunk size,
+// the default of 4 results in sizes growing by approximately 1.25x
+#define MEMPOOL_EXT_STEPS       4
+#endif
+
+#ifndef MEMPOOL_STATS
+// collect per-pool allocation counters, see MemPool::Stats()
+#define MEMPOOL_STATS           0
+#endif
+
+#if MEMPOOL_STATS
+#include <base/format.h>
+
+//! Counters collected for each pool when MEMPOOL_STATS is enabled
+struct MemPoolStats
+{
+    uint32_t size;      //!< Size of the blocks in the pool
+    uint32_t live;      //!< Number of blocks currently allocated from the pool
+    uint32_t free;      //!< Number of blocks currently waiting in the freelist
+    uint32_t peak;      //!< Maximum number of blocks allocated at the same time
+    uint32_t allocs;    //!< Total number of allocations
+    uint32_t frees;     //!< Total number of deallocations
+    uint32_t refills;   //!< Number of blocks obtained from malloc
+};
+#endif
+
 struct MemPoolEntry
 {
     union
@@ -43,6 +77,12 @@ class MemPool
     int cnt = 0;
     mono_t lastDump = 0;
 #endif
+#if MEMPOOL_STATS
+    MemPool* next = NULL;   //!< Next pool in the list of registered pools
+    uint32_t allocs = 0, frees = 0, refills = 0, peak = 0;
+
+    static MemPool* s_first;
+#endif
 
 public:
     constexpr MemPool(const size_t size) : free(NULL), size(size)
@@ -54,6 +94,21 @@ public:
 
     const uintptr_t* WatchPointer() const { return (const uintptr_t*)&free; }
 
+#if MEMPOOL_STATS
+    //! Gets the first pool that has been used so far, pools register themselves when allocating their first block
+    static MemPool* First() { return s_first; }
+    //! Gets the next registered pool
+    MemPool* Next() const { return next; }
+    //! Gets a snapshot of the counters of the pool
+    MemPoolStats Stats() const { return { uint32_t(size), allocs - frees, refills - (allocs - frees), peak, allocs, frees, refills }; }
+
+    //! Writes the counters of all registered pools as a JSON array
+    static int DumpJson(format_output output, void* context);
+    //! Writes the counters of all registered pools as consecutive @ref MemPoolStats records in native byte order
+    //! @returns the number of bytes required for all the records, which can be more than @p length
+    static size_t DumpBinary(void* buffer, size_t length);
+#endif
+
 private:
     void* AllocDynamic();
     void* AllocNew();
@@ -69,10 +124,24 @@ private:
 #endif
 };
 
+// calculates the size of the extended pool for sizes above MEMPOOL_MAX_SIZE
+constexpr size_t __MemPoolExtSize(size_t size)
+{
+    size_t top = MEMPOOL_MAX_SIZE;
+    while (top < size)
+    {
+        top <<= 1;
+    }
+    // divide the range between top / 2 and top into MEMPOOL_EXT_STEPS pointer-aligned steps
+    size_t step = ((top >> 1) / MEMPOOL_EXT_STEPS + sizeof(intptr_t) - 1) & ~(sizeof(intptr_t) - 1);
+    return (size + step - 1) / step * step;
+}
+
 // calculates the size of the pool to be used for an arbitrary size/type
 template<size_t size> constexpr size_t MemPoolSize()
 {
-    return size > MEMPOOL_MAX_SIZE ? 0 :
+    return size > MEMPOOL_MAX_SIZE ?
+            (size > MEMPOOL_EXT_MAX_SIZE ? 0 : __MemPoolExtSize(size)) :
         ((size < MEMPOOL_MIN_SIZE ? MEMPOOL_MIN_SIZE : size) + MEMPOOL_GRANULARITY - 1) & ~(MEMPOOL_GRANULARITY - 1);
 }
 
@@ -92,7 +161,7 @@ template<size_t size> class MemPool __MemPoolInstance<size>::s_instance(size);
 
 template<size_t size> ALWAYS_INLINE void* MemPoolAlloc()
 {
-    if (size > MEMPOOL_MAX_SIZE)
+    if (!MemPoolSize<size>())
         return MemPool::AllocLarge(size);
     else
         return __MemPoolInstance<MemPoolSize<size>()>::s_instance.Alloc();
@@ -101,7 +170,7 @@ template<typename T> ALWAYS_INLINE T* MemPoolAlloc() { return (T*)MemPoolAlloc<s
 
 template<size_t size> ALWAYS_INLINE void MemPoolFree(void* ptr)
 {
-    if (size > MEMPOOL_MAX_SIZE)
+    if (!MemPoolSize<size>())
         free(ptr);
     else
         __MemPoolInstance<MemPoolSize<size>()>::s_instance.Free(ptr);
@@ -111,7 +180,7 @@ template<typename T> ALWAYS_INLINE void MemPoolFree(T* entry) { return MemPoolFr
 template<size_t size> ALWAYS_INLINE void* MemPoolAllocDynamic()
 {
     constexpr auto poolSize = size + sizeof(class MemPool*);
-    if (poolSize > MEMPOOL_MAX_SIZE)
+    if (!MemPoolSize<poolSize>())
     {
         // leaving the pool pointer NULL means memory was allocated dynamically
         return MemPool::AllocLarge(poolSize) + 1;
@@ -127,7 +196,7 @@ void MemPoolFreeDynamic(void* mem);
 
 template<size_t size> ALWAYS_INLINE constexpr MemPool* MemPoolGet()
 {
-    if (size > MEMPOOL_MAX_SIZE)
+    if (!MemPoolSize<size>())
         return NULL;
     else
         return &__MemPoolInstance<MemPoolSize<size>()>::s_instance;
@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/MemPoolAllocator.h
+ *
+ * Standard library allocator adapter serving single objects from MemPool
+ */
+
+#pragma once
+
+#include <base/base.h>
+#include <base/MemPool.h>
+
+//! Allocator for standard containers that takes single-element allocations
+//! (list/map nodes, shared_ptr control blocks) from the matching MemPool,
+//! array allocations (vector storage, hash buckets) fall back to malloc
+template<typename T> struct MemPoolAllocator
+{
+    typedef T value_type;
+
+    constexpr MemPoolAllocator() noexcept {}
+    template<typename U> constexpr MemPoolAllocator(const MemPoolAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n)
+    {
+        if (n == 1)
+            return MemPoolAlloc<T>();
+#if MEMPOOL_NO_MALLOC
+        return NULL;
+#else
+        return (T*)malloc(n * sizeof(T));
+#endif
+    }
+
+    void deallocate(T* p, size_t n)
+    {
+        if (n == 1)
+            MemPoolFree<T>(p);
+        else
+            free(p);
+    }
+
+    // all instances are interchangeable, the pools are global
+    template<typename U> constexpr bool operator ==(const MemPoolAllocator<U>&) const noexcept { return true; }
+    template<typename U> constexpr bool operator !=(const MemPoolAllocator<U>&) const noexcept { return false; }
+};
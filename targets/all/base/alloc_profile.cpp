@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/alloc_profile.cpp
+ */
+
+#include "alloc_profile.h"
+
+#if ALLOC_TRACE_PROFILE
+
+#include <algorithm>
+
+#if Thost
+#include <dlfcn.h>
+#endif
+
+static_assert(!(ALLOC_TRACE_PROFILE_SITES & (ALLOC_TRACE_PROFILE_SITES - 1)), "ALLOC_TRACE_PROFILE_SITES must be a power of two");
+
+#if ALLOC_TRACE_PROFILE_SAMPLE > 1
+static_assert(!(ALLOC_TRACE_PROFILE_LIVE & (ALLOC_TRACE_PROFILE_LIVE - 1)), "ALLOC_TRACE_PROFILE_LIVE must be a power of two");
+
+//! Live sampled block and the site it was allocated from
+struct AllocSample
+{
+    const void* ptr;
+    AllocSite* site;
+};
+#endif
+
+//! Cumulative statistics, an open-addressing hash table indexed by origin and size
+static struct
+{
+    AllocSite sites[ALLOC_TRACE_PROFILE_SITES];
+    size_t dropped;
+#if ALLOC_TRACE_PROFILE_SAMPLE > 1
+    //! Live sampled blocks, an open-addressing hash table indexed by the block pointer
+    AllocSample live[ALLOC_TRACE_PROFILE_LIVE];
+#endif
+} s_profile;
+
+ALWAYS_INLINE static size_t site_hash(const void* origin, size_t size)
+{
+    return ((uintptr_t(origin) >> 1) ^ (size * 0x9E3779B1u)) & (ALLOC_TRACE_PROFILE_SITES - 1);
+}
+
+//! Finds or inserts a site in a hash table with ALLOC_TRACE_PROFILE_SITES entries, returns NULL if the table is full
+static AllocSite* site_get(AllocSite* table, const void* origin, size_t size)
+{
+    auto i = site_hash(origin, size);
+    for (size_t n = 0; n < ALLOC_TRACE_PROFILE_SITES; n++, i = (i + 1) & (ALLOC_TRACE_PROFILE_SITES - 1))
+    {
+        auto& site = table[i];
+        if (site.origin == origin && site.size == size)
+        {
+            return &site;
+        }
+        if (!site.origin)
+        {
+            site.origin = origin;
+            site.size = size;
+            return &site;
+        }
+    }
+    return NULL;
+}
+
+#if ALLOC_TRACE_PROFILE_SAMPLE == 1
+
+void ___profile_alloc(const void* origin, size_t size)
+{
+    if (auto site = site_get(s_profile.sites, origin, size))
+    {
+        site->allocs++;
+    }
+    else
+    {
+        s_profile.dropped++;
+    }
+}
+
+#else
+
+unsigned __profile_sample_countdown = ALLOC_TRACE_PROFILE_SAMPLE;
+size_t __profile_sample_live;
+
+ALWAYS_INLINE static size_t sample_hash(const void* ptr)
+{
+    return ((uintptr_t(ptr) >> 3) * 0x9E3779B1u) & (ALLOC_TRACE_PROFILE_LIVE - 1);
+}
+
+void ___profile_sample_alloc(void* ptr, size_t size, const void* origin)
+{
+    __profile_sample_countdown = ALLOC_TRACE_PROFILE_SAMPLE;
+
+    auto site = site_get(s_profile.sites, origin, size);
+    // one entry is always left empty to terminate the lookups
+    if (!site || __profile_sample_live == ALLOC_TRACE_PROFILE_LIVE - 1)
+    {
+        s_profile.dropped++;
+        return;
+    }
+
+    site->allocs++;
+    site->live++;
+    __profile_sample_live++;
+    auto i = sample_hash(ptr);
+    while (s_profile.live[i].ptr)
+    {
+        i = (i + 1) & (ALLOC_TRACE_PROFILE_LIVE - 1);
+    }
+    s_profile.live[i] = { ptr, site };
+}
+
+void ___profile_sample_free(void* ptr)
+{
+    auto i = sample_hash(ptr);
+    while (s_profile.live[i].ptr != ptr)
+    {
+        if (!s_profile.live[i].ptr)
+        {
+            // not a sampled block
+            return;
+        }
+        i = (i + 1) & (ALLOC_TRACE_PROFILE_LIVE - 1);
+    }
+
+    s_profile.live[i].site->live--;
+    __profile_sample_live--;
+
+    // shift the following entries of the probe sequence back into the hole, so lookups never stop early
+    for (auto j = i;;)
+    {
+        j = (j + 1) & (ALLOC_TRACE_PROFILE_LIVE - 1);
+        auto& e = s_profile.live[j];
+        if (!e.ptr)
+        {
+            break;
+        }
+        // distance from the home slot of the entry, it can move only if the hole lies within it
+        if (((j - sample_hash(e.ptr)) & (ALLOC_TRACE_PROFILE_LIVE - 1)) >= ((j - i) & (ALLOC_TRACE_PROFILE_LIVE - 1)))
+        {
+            s_profile.live[i] = e;
+            i = j;
+        }
+    }
+    s_profile.live[i].ptr = NULL;
+}
+
+#endif
+
+void AllocProfile::Capture()
+{
+    // start with the cumulative table, keeping the same layout for lookups
+    memcpy(sites, s_profile.sites, sizeof(sites));
+    dropped = s_profile.dropped;
+
+#if ALLOC_TRACE_PROFILE_SAMPLE == 1
+    // live blocks are collected exactly from the trace list, sampled ones are counted as they come and go
+    for (auto node = __alloc_trace.next; node != &__alloc_trace; node = node->next)
+    {
+        if (auto site = site_get(sites, node->origin, node->size))
+        {
+            site->live++;
+        }
+        else
+        {
+            dropped++;
+        }
+    }
+#endif
+
+    // compact and sort for lookups and comparisons
+    auto e = std::remove_if(sites, endof(sites), [](const AllocSite& s) { return !s.origin; });
+    std::sort(sites, e, [](const AllocSite& a, const AllocSite& b) { return a.origin < b.origin || (a.origin == b.origin && a.size < b.size); });
+    count = e - sites;
+}
+
+const AllocSite* AllocProfile::Find(const void* origin, size_t size) const
+{
+    auto e = end();
+    auto p = std::lower_bound(begin(), e, origin, [size](const AllocSite& s, const void* origin) { return s.origin < origin || (s.origin == origin && s.size < size); });
+    return p != e && p->origin == origin && p->size == size ? p : NULL;
+}
+
+//! Formats an address or offset in hex, format works with 32-bit values so wider ones are split in halves
+static int report_hex(format_output output, void* context, uintptr_t value)
+{
+#if UINTPTR_MAX > UINT32_MAX
+    if (auto high = unsigned(uint64_t(value) >> 32))
+    {
+        return format(output, context, "0x%X%08X", high, unsigned(value));
+    }
+#endif
+    return format(output, context, "0x%X", unsigned(value));
+}
+
+static int report_origin(format_output output, void* context, const void* origin)
+{
+#if Thost
+    Dl_info info;
+    if (dladdr(origin, &info) && info.dli_fname)
+    {
+        return format(output, context, "%s+", info.dli_fname) +
+            report_hex(output, context, (const char*)origin - (const char*)info.dli_fbase);
+    }
+#endif
+    return report_hex(output, context, uintptr_t(origin));
+}
+
+int AllocProfile::Report(format_output output, void* context, const AllocProfile* baseline) const
+{
+    int res = 0;
+    for (auto& site: *this)
+    {
+        auto base = baseline ? baseline->Find(site.origin, site.size) : NULL;
+        int live = (site.live - (base ? base->live : 0)) * SampleRate;
+        int allocs = (site.allocs - (base ? base->allocs : 0)) * SampleRate;
+        if (baseline && !live && !allocs)
+        {
+            continue;
+        }
+
+        res += report_origin(output, context, site.origin);
+        if (baseline)
+        {
+            res += format(output, context, " size %u live %u (%+d) allocs %u (%+d)\n",
+                unsigned(site.size), site.live * SampleRate, live, site.allocs * SampleRate, allocs);
+        }
+        else
+        {
+            res += format(output, context, " size %u live %u allocs %u\n",
+                unsigned(site.size), site.live * SampleRate, site.allocs * SampleRate);
+        }
+    }
+
+    if (baseline)
+    {
+        // report sites that disappeared completely
+        for (auto& site: *baseline)
+        {
+            if (site.live && !Find(site.origin, site.size))
+            {
+                res += report_origin(output, context, site.origin);
+                res += format(output, context, " size %u live 0 (%d)\n", unsigned(site.size), -int(site.live * SampleRate));
+            }
+        }
+    }
+
+    if (dropped)
+    {
+        res += format(output, context, "dropped %u\n", unsigned(dropped));
+    }
+    return res;
+}
+
+#endif
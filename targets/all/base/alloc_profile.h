@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/alloc_profile.h
+ *
+ * Aggregated allocation-site profiling, exact on top of allocation tracing,
+ * or sampling only every ALLOC_TRACE_PROFILE_SAMPLE-th allocation, in which case
+ * the blocks in between are neither traced nor given the tracing overhead
+ */
+
+#pragma once
+
+#include <base/base.h>
+#include <base/format.h>
+
+#include <base/alloc_trace.h>
+
+#if ALLOC_TRACE_PROFILE
+
+#ifndef ALLOC_TRACE_PROFILE_SITES
+// maximum number of distinct origin/size combinations tracked, must be a power of two
+#define ALLOC_TRACE_PROFILE_SITES   256
+#endif
+
+#if ALLOC_TRACE_PROFILE_SAMPLE > 1 && !defined(ALLOC_TRACE_PROFILE_LIVE)
+// maximum number of sampled blocks tracked while they are live, must be a power of two
+#define ALLOC_TRACE_PROFILE_LIVE    256
+#endif
+
+//! Aggregated allocations from a single origin with the same size (class)
+struct AllocSite
+{
+    const void* origin;     //!< Return address of the allocation call
+    size_t size;            //!< Size of the allocated blocks
+    uint32_t live;          //!< Number of (sampled) blocks allocated at the time of the snapshot
+    uint32_t allocs;        //!< Cumulative number of (sampled) allocations
+};
+
+//! Snapshot of allocations aggregated by origin and size
+class AllocProfile
+{
+public:
+    //! Captures the current state of all tracked allocation sites
+    void Capture();
+
+    //! Gets the number of sites in the snapshot
+    size_t Count() const { return count; }
+    //! Gets the number of sites that could not be tracked because the site table is full
+    size_t Dropped() const { return dropped; }
+    //! Finds the site with the specified origin and size, returns NULL if not present
+    const AllocSite* Find(const void* origin, size_t size) const;
+
+    const AllocSite* begin() const { return sites; }
+    const AllocSite* end() const { return sites + count; }
+
+    //! Writes a report of all sites in the snapshot, one line per site
+    /*!
+     * If @p baseline is specified, only sites that changed since the baseline
+     * are reported, with the differences in live and cumulative allocation counts.
+     * On host, origins are reported as "module+0xoffset", suitable for addr2line
+     */
+    int Report(format_output output, void* context, const AllocProfile* baseline = NULL) const;
+
+    //! Multiplier to estimate real allocation counts from the sampled ones
+    static constexpr unsigned SampleRate = ALLOC_TRACE_PROFILE_SAMPLE;
+
+private:
+    size_t count, dropped;
+    AllocSite sites[ALLOC_TRACE_PROFILE_SITES];
+};
+
+#if ALLOC_TRACE_PROFILE_SAMPLE == 1
+//! Records an allocation in the cumulative statistics, called from the allocation tracer
+EXTERN_C void ___profile_alloc(const void* origin, size_t size);
+#endif
+
+#endif
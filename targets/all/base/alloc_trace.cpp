@@ -7,6 +7,7 @@
  */
 
 #include "alloc_trace.h"
+#include "alloc_profile.h"
 
 #if ALLOC_TRACE_ENABLE
 
@@ -44,6 +45,9 @@ void ___trace_alloc(void* ptr, size_t size, const void* origin)
     node->size = size;
     node->origin = origin;
     insert_after(__alloc_trace, *node);
+#if ALLOC_TRACE_PROFILE && ALLOC_TRACE_PROFILE_SAMPLE == 1
+    ___profile_alloc(origin, size);
+#endif
 }
 
 void ___trace_free(void* ptr)
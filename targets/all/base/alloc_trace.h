@@ -12,6 +12,40 @@
 
 #include <base/base.h>
 
+#if ALLOC_TRACE_PROFILE
+
+#ifndef ALLOC_TRACE_PROFILE_SAMPLE
+// only every N-th allocation is profiled, see base/alloc_profile.h
+#define ALLOC_TRACE_PROFILE_SAMPLE  1
+#endif
+
+// exact allocation profiling requires tracing, sampled profiling keeps track of the sampled blocks itself
+#if ALLOC_TRACE_PROFILE_SAMPLE == 1 && !defined(ALLOC_TRACE_ENABLE)
+#define ALLOC_TRACE_ENABLE  1
+#endif
+
+#endif
+
+#if ALLOC_TRACE_PROFILE && ALLOC_TRACE_PROFILE_SAMPLE > 1
+
+EXTERN_C void ___profile_sample_alloc(void* ptr, size_t size, const void* origin);
+EXTERN_C void ___profile_sample_free(void* ptr);
+
+extern unsigned __profile_sample_countdown;
+extern size_t __profile_sample_live;
+
+// the allocations in between samples only decrement the countdown,
+// frees are looked up only while any sampled blocks are live
+#define __profile_sample_alloc(ptr, size)   ({ if (!--__profile_sample_countdown) { ___profile_sample_alloc(ptr, size, __builtin_return_address(0)); } })
+#define __profile_sample_free(ptr)          ({ if (__profile_sample_live) { ___profile_sample_free(ptr); } })
+
+#else
+
+#define __profile_sample_alloc(...)
+#define __profile_sample_free(...)
+
+#endif
+
 #if ALLOC_TRACE_ENABLE
 
 struct __alloc_node
@@ -30,14 +64,14 @@ EXTERN_C void ___trace_free(void* ptr);
 
 extern __alloc_node __alloc_trace;
 
-#define __trace_alloc(ptr, size)    ___trace_alloc(ptr, size, __builtin_return_address(0))
-#define __trace_free(ptr)           ___trace_free(ptr)
+#define __trace_alloc(ptr, size)    ({ ___trace_alloc(ptr, size, __builtin_return_address(0)); __profile_sample_alloc(ptr, size); })
+#define __trace_free(ptr)           ({ ___trace_free(ptr); __profile_sample_free(ptr); })
 
 #else
 
 #define ALLOC_TRACE_OVERHEAD    0
 
-#define __trace_alloc(...)
-#define __trace_free(...)
+#define __trace_alloc(ptr, size)    __profile_sample_alloc(ptr, size)
+#define __trace_free(ptr)           __profile_sample_free(ptr)
 
 #endif
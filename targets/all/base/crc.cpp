@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/crc.cpp
+ *
+ * Slicing-by-8 uses a table per byte of the step, the table for a byte being
+ * the CRC of that byte followed by as many zero bytes as follow it in the step,
+ * so the CRCs of all eight bytes combine with a simple XOR
+ */
+
+#include <base/base.h>
+#include <base/crc.h>
+
+#if __SSE4_2__
+#include <nmmintrin.h>
+#define CRC_SSE42_TARGET
+#elif __ARM_FEATURE_CRC32
+#include <arm_acle.h>
+#elif (__x86_64__ || __i386__) && __GNUC__
+// generic x86 builds check once whether the CPU has the CRC instructions
+#include <nmmintrin.h>
+#define CRC_SSE42_DETECT    1
+#define CRC_SSE42_TARGET    __attribute__((target("sse4.2")))
+#endif
+
+static_assert(CRC_SLICES == 8 || CRC_SLICES == 1, "CRC_SLICES must be 8 or 1");
+
+namespace
+{
+
+template<typename T, T Poly, bool Reflected> struct Tables
+{
+    static constexpr unsigned Bits = sizeof(T) * 8;
+
+    T t[CRC_SLICES][256];
+
+    constexpr Tables() : t()
+    {
+        for (unsigned i = 0; i < 256; i++)
+        {
+            T crc = Reflected ? T(i) : T(i << (Bits - 8));
+            for (unsigned b = 0; b < 8; b++)
+            {
+                if (Reflected)
+                    crc = crc & 1 ? T((crc >> 1) ^ Poly) : T(crc >> 1);
+                else
+                    crc = crc >> (Bits - 1) ? T((crc << 1) ^ Poly) : T(crc << 1);
+            }
+            t[0][i] = crc;
+        }
+
+        // each further table adds a zero byte after the one looked up
+        for (unsigned s = 1; s < CRC_SLICES; s++)
+        {
+            for (unsigned i = 0; i < 256; i++)
+            {
+                T prev = t[s - 1][i];
+                t[s][i] = Reflected ? T((prev >> 8) ^ t[0][prev & 0xFF]) : T((prev << 8) ^ t[0][prev >> (Bits - 8)]);
+            }
+        }
+    }
+};
+
+#if !(__ARM_FEATURE_CRC32)
+constexpr Tables<uint32_t, 0xEDB88320u, true> crc32Tables;
+#endif
+#if !(__SSE4_2__ || __ARM_FEATURE_CRC32)
+constexpr Tables<uint32_t, 0x82F63B78u, true> crc32cTables;
+#endif
+constexpr Tables<uint16_t, 0x1021, false> crc16ccittTables;
+constexpr Tables<uint16_t, 0xA001, true> crc16modbusTables;
+
+ALWAYS_INLINE uint32_t Load32LE(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return FROM_LE32(v); }
+
+//! CRC with the least significant bit first, the register lines up with the first bytes of the step
+template<typename T> T UpdateReflected(const T (*t)[256], const uint8_t* p, size_t length, T crc)
+{
+#if CRC_SLICES == 8
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint32_t lo = Load32LE(p) ^ crc;
+        uint32_t hi = Load32LE(p + 4);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+            t[3][hi & 0xFF] ^ t[2][(hi >> 8) & 0xFF] ^ t[1][(hi >> 16) & 0xFF] ^ t[0][hi >> 24];
+    }
+#endif
+    for (; length; length--)
+    {
+        crc = T((crc >> 8) ^ t[0][(crc ^ *p++) & 0xFF]);
+    }
+    return crc;
+}
+
+//! 16-bit CRC with the most significant bit first, the register lines up with the first two bytes of the step
+uint16_t UpdateNormal16(const uint16_t (*t)[256], const uint8_t* p, size_t length, uint16_t crc)
+{
+#if CRC_SLICES == 8
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        crc = t[7][p[0] ^ (crc >> 8)] ^ t[6][p[1] ^ (crc & 0xFF)] ^ t[5][p[2]] ^ t[4][p[3]] ^
+            t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+#endif
+    for (; length; length--)
+    {
+        crc = uint16_t((crc << 8) ^ t[0][(crc >> 8) ^ *p++]);
+    }
+    return crc;
+}
+
+#if __SSE4_2__ || CRC_SSE42_DETECT
+//! CRC32C using the SSE4.2 CRC instruction, eight bytes at a time on 64-bit targets
+CRC_SSE42_TARGET uint32_t UpdateSse42(const uint8_t* p, size_t length, uint32_t crc)
+{
+#if __x86_64__
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = _mm_crc32_u64(crc, v);
+    }
+#else
+    for (; length >= 4; p += 4, length -= 4)
+    {
+        uint32_t v;
+        memcpy(&v, p, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+#endif
+    for (; length; length--)
+    {
+        crc = _mm_crc32_u8(crc, *p++);
+    }
+    return crc;
+}
+#endif
+
+#if CRC_SSE42_DETECT
+bool HasSse42()
+{
+    // the CPU model may not be initialized yet when called from a static constructor
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+#endif
+
+}
+
+uint32_t crc32(const void* data, size_t length, uint32_t crc)
+{
+    auto p = (const uint8_t*)data;
+    crc = ~crc;
+#if __ARM_FEATURE_CRC32
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32d(crc, v);
+    }
+    for (; length; length--)
+    {
+        crc = __crc32b(crc, *p++);
+    }
+#else
+    crc = UpdateReflected(crc32Tables.t, p, length, crc);
+#endif
+    return ~crc;
+}
+
+uint32_t crc32c(const void* data, size_t length, uint32_t crc)
+{
+    auto p = (const uint8_t*)data;
+    crc = ~crc;
+#if __SSE4_2__
+    crc = UpdateSse42(p, length, crc);
+#elif __ARM_FEATURE_CRC32
+    for (; length >= 8; p += 8, length -= 8)
+    {
+        uint64_t v;
+        memcpy(&v, p, 8);
+        crc = __crc32cd(crc, v);
+    }
+    for (; length; length--)
+    {
+        crc = __crc32cb(crc, *p++);
+    }
+#else
+#if CRC_SSE42_DETECT
+    static const bool sse42 = HasSse42();
+    if (sse42)
+    {
+        return ~UpdateSse42(p, length, crc);
+    }
+#endif
+    crc = UpdateReflected(crc32cTables.t, p, length, crc);
+#endif
+    return ~crc;
+}
+
+uint16_t crc16ccitt(const void* data, size_t length, uint16_t crc)
+{
+    return UpdateNormal16(crc16ccittTables.t, (const uint8_t*)data, length, crc);
+}
+
+uint16_t crc16modbus(const void* data, size_t length, uint16_t crc)
+{
+    return UpdateReflected(crc16modbusTables.t, (const uint8_t*)data, length, crc);
+}
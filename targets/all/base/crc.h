@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/crc.h
+ *
+ * Table-driven CRC calculations processing eight bytes per lookup step, with
+ * CRC32C (and CRC32 on ARM) using the CRC instructions when the target has them;
+ * x86 builds that do not assume SSE4.2 detect the instructions at runtime
+ *
+ * All functions continue the calculation from the value returned for the
+ * preceding data, so the CRC of data split into multiple blocks (such as pipe
+ * segments) is calculated block by block without copying it together
+ */
+
+#pragma once
+
+#include <base/base.h>
+#include <base/Span.h>
+
+//! Number of bytes processed in a single table lookup step (8 or 1), each byte needs another table per CRC (1 kB for CRC32, 512 B for CRC16)
+#ifndef CRC_SLICES
+#define CRC_SLICES      8
+#endif
+
+//! Calculates CRC-32 (IEEE 802.3, as used by Ethernet and zlib)
+uint32_t crc32(const void* data, size_t length, uint32_t crc = 0);
+//! Calculates CRC-32C (Castagnoli, as used by iSCSI and ext4)
+uint32_t crc32c(const void* data, size_t length, uint32_t crc = 0);
+//! Calculates CRC-16/CCITT-FALSE, or CRC-16/XMODEM when starting from zero
+uint16_t crc16ccitt(const void* data, size_t length, uint16_t crc = 0xFFFF);
+//! Calculates CRC-16/MODBUS
+uint16_t crc16modbus(const void* data, size_t length, uint16_t crc = 0xFFFF);
+
+inline uint32_t crc32(Span data, uint32_t crc = 0) { return crc32(data.Pointer(), data.Length(), crc); }
+inline uint32_t crc32c(Span data, uint32_t crc = 0) { return crc32c(data.Pointer(), data.Length(), crc); }
+inline uint16_t crc16ccitt(Span data, uint16_t crc = 0xFFFF) { return crc16ccitt(data.Pointer(), data.Length(), crc); }
+inline uint16_t crc16modbus(Span data, uint16_t crc = 0xFFFF) { return crc16modbus(data.Pointer(), data.Length(), crc); }
+
+//! Incremental CRC calculation over multiple blocks of data
+template<typename T, T (*Fn)(const void*, size_t, T), T Initial> class Crc
+{
+public:
+    constexpr Crc(T value = Initial) : value(value) {}
+
+    Crc& Update(const void* data, size_t length) { value = Fn(data, length, value); return *this; }
+    Crc& Update(Span data) { return Update(data.Pointer(), data.Length()); }
+    //! Continues the calculation over a sequence of spans, such as the segments enumerated by Pipe::SpanIterator
+    template<typename TSpans> Crc& UpdateSpans(const TSpans& spans) { for (Span s: spans) Update(s); return *this; }
+
+    constexpr T Value() const { return value; }
+    constexpr operator T() const { return value; }
+
+private:
+    T value;
+};
+
+using CRC32 = Crc<uint32_t, crc32, 0>;
+using CRC32C = Crc<uint32_t, crc32c, 0>;
+using CRC16CCITT = Crc<uint16_t, crc16ccitt, 0xFFFF>;
+using CRC16XModem = Crc<uint16_t, crc16ccitt, 0>;
+using CRC16Modbus = Crc<uint16_t, crc16modbus, 0xFFFF>;
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/memsearch.cpp
+ *
+ * The substring search compares each vector of candidate positions against
+ * both the first and the last byte of the needle, only positions matching
+ * both are verified with memcmp
+ */
+
+#include <base/base.h>
+#include <base/memsearch.h>
+
+#if __AVX2__ || __SSE2__
+#include <immintrin.h>
+#elif __ARM_NEON
+#include <arm_neon.h>
+#endif
+
+// largest set searched by comparing against each of its bytes, larger sets use a lookup table
+#define MEMFINDANY_VECTOR_SET   8
+
+namespace
+{
+
+#if __AVX2__
+
+typedef __m256i vec_t;
+constexpr size_t VecSize = 32;
+constexpr unsigned MaskStep = 1;        // bits per byte in the mask returned by Mask
+
+ALWAYS_INLINE vec_t Splat(uint8_t b) { return _mm256_set1_epi8(b); }
+ALWAYS_INLINE vec_t Load(const uint8_t* p) { return _mm256_loadu_si256((const vec_t*)p); }
+ALWAYS_INLINE vec_t Eq(vec_t a, vec_t b) { return _mm256_cmpeq_epi8(a, b); }
+ALWAYS_INLINE vec_t And(vec_t a, vec_t b) { return _mm256_and_si256(a, b); }
+ALWAYS_INLINE vec_t Or(vec_t a, vec_t b) { return _mm256_or_si256(a, b); }
+ALWAYS_INLINE uint64_t Mask(vec_t v) { return uint32_t(_mm256_movemask_epi8(v)); }
+constexpr uint64_t FullMask = 0xFFFFFFFF;
+
+#elif __SSE2__
+
+typedef __m128i vec_t;
+constexpr size_t VecSize = 16;
+constexpr unsigned MaskStep = 1;
+
+ALWAYS_INLINE vec_t Splat(uint8_t b) { return _mm_set1_epi8(b); }
+ALWAYS_INLINE vec_t Load(const uint8_t* p) { return _mm_loadu_si128((const vec_t*)p); }
+ALWAYS_INLINE vec_t Eq(vec_t a, vec_t b) { return _mm_cmpeq_epi8(a, b); }
+ALWAYS_INLINE vec_t And(vec_t a, vec_t b) { return _mm_and_si128(a, b); }
+ALWAYS_INLINE vec_t Or(vec_t a, vec_t b) { return _mm_or_si128(a, b); }
+ALWAYS_INLINE uint64_t Mask(vec_t v) { return uint16_t(_mm_movemask_epi8(v)); }
+constexpr uint64_t FullMask = 0xFFFF;
+
+#elif __ARM_NEON
+
+typedef uint8x16_t vec_t;
+constexpr size_t VecSize = 16;
+constexpr unsigned MaskStep = 4;
+
+ALWAYS_INLINE vec_t Splat(uint8_t b) { return vdupq_n_u8(b); }
+ALWAYS_INLINE vec_t Load(const uint8_t* p) { return vld1q_u8(p); }
+ALWAYS_INLINE vec_t Eq(vec_t a, vec_t b) { return vceqq_u8(a, b); }
+ALWAYS_INLINE vec_t And(vec_t a, vec_t b) { return vandq_u8(a, b); }
+ALWAYS_INLINE vec_t Or(vec_t a, vec_t b) { return vorrq_u8(a, b); }
+// there is no movemask, narrowing each byte to a nibble keeps one bit per byte after masking
+ALWAYS_INLINE uint64_t Mask(vec_t v) { return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0) & 0x8888888888888888ull; }
+constexpr uint64_t FullMask = 0x8888888888888888ull;
+
+#else
+
+#define MEMSEARCH_SCALAR    1
+
+#endif
+
+#ifndef MEMSEARCH_SCALAR
+
+ALWAYS_INLINE size_t FirstIndex(uint64_t mask) { return __builtin_ctzll(mask) / MaskStep; }
+ALWAYS_INLINE size_t Count(uint64_t mask) { return __builtin_popcountll(mask); }
+
+#endif
+
+const uint8_t* ScalarSearch(const uint8_t* p, const uint8_t* end, const uint8_t* needle, size_t needleLength)
+{
+    while (p + needleLength <= end)
+    {
+        if (!(p = (const uint8_t*)memchr(p, needle[0], end - p - needleLength + 1)))
+        {
+            break;
+        }
+        if (!memcmp(p + 1, needle + 1, needleLength - 1))
+        {
+            return p;
+        }
+        p++;
+    }
+    return NULL;
+}
+
+const uint8_t* ScalarFindAny(const uint8_t* p, const uint8_t* end, const uint8_t* set, size_t setLength)
+{
+    uint32_t table[8] = {};
+    for (size_t i = 0; i < setLength; i++)
+    {
+        table[set[i] >> 5] |= 1u << (set[i] & 31);
+    }
+
+    for (; p < end; p++)
+    {
+        if (table[*p >> 5] & (1u << (*p & 31)))
+        {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+const uint8_t* ScalarSkipAny(const uint8_t* p, const uint8_t* end, const uint8_t* set, size_t setLength)
+{
+    uint32_t table[8] = {};
+    for (size_t i = 0; i < setLength; i++)
+    {
+        table[set[i] >> 5] |= 1u << (set[i] & 31);
+    }
+
+    for (; p < end; p++)
+    {
+        if (!(table[*p >> 5] & (1u << (*p & 31))))
+        {
+            return p;
+        }
+    }
+    return NULL;
+}
+
+}
+
+const void* memsearch(const void* data, size_t length, const void* needle, size_t needleLength)
+{
+    auto p = (const uint8_t*)data;
+    auto end = p + length;
+    auto n = (const uint8_t*)needle;
+
+    if (needleLength <= 1)
+    {
+        return needleLength ? memchr(data, n[0], length) : data;
+    }
+
+#ifndef MEMSEARCH_SCALAR
+    if (length >= needleLength - 1 + VecSize)
+    {
+        vec_t first = Splat(n[0]);
+        vec_t last = Splat(n[needleLength - 1]);
+        // the last vector must not read beyond the end of the block
+        auto vend = end - (needleLength - 1) - VecSize;
+
+        for (; p <= vend; p += VecSize)
+        {
+            uint64_t mask = Mask(And(Eq(Load(p), first), Eq(Load(p + needleLength - 1), last)));
+            while (mask)
+            {
+                auto candidate = p + FirstIndex(mask);
+                if (!memcmp(candidate + 1, n + 1, needleLength - 2))
+                {
+                    return candidate;
+                }
+                mask &= mask - 1;
+            }
+        }
+    }
+#endif
+
+    return ScalarSearch(p, end, n, needleLength);
+}
+
+const void* memfindany(const void* data, size_t length, const void* set, size_t setLength)
+{
+    auto p = (const uint8_t*)data;
+    auto end = p + length;
+    auto s = (const uint8_t*)set;
+
+    if (setLength <= 1)
+    {
+        return setLength ? memchr(data, s[0], length) : NULL;
+    }
+
+#ifndef MEMSEARCH_SCALAR
+    if (setLength <= MEMFINDANY_VECTOR_SET)
+    {
+        vec_t bytes[MEMFINDANY_VECTOR_SET];
+        for (size_t i = 0; i < setLength; i++)
+        {
+            bytes[i] = Splat(s[i]);
+        }
+
+        for (; p + VecSize <= end; p += VecSize)
+        {
+            vec_t v = Load(p);
+            vec_t eq = Eq(v, bytes[0]);
+            for (size_t i = 1; i < setLength; i++)
+            {
+                eq = Or(eq, Eq(v, bytes[i]));
+            }
+            if (uint64_t mask = Mask(eq))
+            {
+                return p + FirstIndex(mask);
+            }
+        }
+    }
+#endif
+
+    return ScalarFindAny(p, end, s, setLength);
+}
+
+const void* memskipany(const void* data, size_t length, const void* set, size_t setLength)
+{
+    auto p = (const uint8_t*)data;
+    auto end = p + length;
+    auto s = (const uint8_t*)set;
+
+#ifndef MEMSEARCH_SCALAR
+    if (setLength && setLength <= MEMFINDANY_VECTOR_SET)
+    {
+        vec_t bytes[MEMFINDANY_VECTOR_SET];
+        for (size_t i = 0; i < setLength; i++)
+        {
+            bytes[i] = Splat(s[i]);
+        }
+
+        for (; p + VecSize <= end; p += VecSize)
+        {
+            vec_t v = Load(p);
+            vec_t eq = Eq(v, bytes[0]);
+            for (size_t i = 1; i < setLength; i++)
+            {
+                eq = Or(eq, Eq(v, bytes[i]));
+            }
+            if (uint64_t mask = ~Mask(eq) & FullMask)
+            {
+                return p + FirstIndex(mask);
+            }
+        }
+    }
+#endif
+
+    return ScalarSkipAny(p, end, s, setLength);
+}
+
+size_t memcount(const void* data, size_t length, uint8_t value)
+{
+    auto p = (const uint8_t*)data;
+    auto end = p + length;
+    size_t n = 0;
+
+#ifndef MEMSEARCH_SCALAR
+    vec_t v = Splat(value);
+    for (; p + VecSize <= end; p += VecSize)
+    {
+        n += Count(Mask(Eq(Load(p), v)));
+    }
+#endif
+
+    for (; p < end; p++)
+    {
+        n += *p == value;
+    }
+    return n;
+}
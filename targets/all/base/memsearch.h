@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/memsearch.h
+ *
+ * Vectorized multi-byte searches and byte scans in memory blocks, using SSE2/AVX2/NEON when
+ * the target supports them and a scalar fallback elsewhere
+ */
+
+#pragma once
+
+#include <base/base.h>
+
+//! Finds the first occurrence of the needle in the memory block (same as memmem)
+//! @returns pointer to the start of the match, or NULL if there is none
+const void* memsearch(const void* data, size_t length, const void* needle, size_t needleLength);
+
+//! Finds the first byte of the memory block that is present in the set
+//! @returns pointer to the matching byte, or NULL if there is none
+const void* memfindany(const void* data, size_t length, const void* set, size_t setLength);
+
+//! Finds the first byte of the memory block that is not present in the set (like strspn)
+//! @returns pointer to the first byte outside the set, or NULL if all of them are in it
+const void* memskipany(const void* data, size_t length, const void* set, size_t setLength);
+
+//! Counts the occurrences of a byte value in the memory block
+size_t memcount(const void* data, size_t length, uint8_t value);
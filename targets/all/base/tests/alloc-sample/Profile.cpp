@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/tests/alloc-sample/Profile.cpp
+ *
+ * Tests aggregation of sampled allocations by origin
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/MemPool.h>
+#include <base/alloc_profile.h>
+
+namespace
+{
+
+// the allocations in between samples are not traced at all
+static_assert(!ALLOC_TRACE_OVERHEAD, "sampled profiling must not reserve tracing space in the blocks");
+
+typedef int8_t Block[MEMPOOL_GRANULARITY * 5];
+
+NO_INLINE Block* AllocBlock()
+{
+    return MemPoolAlloc<Block>();
+}
+
+const AllocSite* FindBySize(const AllocProfile& p, size_t size)
+{
+    for (auto& site: p)
+    {
+        if (site.size == size)
+            return &site;
+    }
+    return NULL;
+}
+
+TEST_CASE("01 Sampled snapshot and diff")
+{
+    static AllocProfile before, during, after;
+
+    before.Capture();
+    // every SampleRate-th of any consecutive allocations is sampled
+    Block* blocks[AllocProfile::SampleRate * 10];
+    for (auto& b: blocks)
+    {
+        b = AllocBlock();
+    }
+    during.Capture();
+    for (auto& b: blocks)
+    {
+        MemPoolFree(b);
+    }
+    after.Capture();
+
+    auto site = FindBySize(during, MemPoolSize<Block>());
+    AssertNotEqual(site, (const AllocSite*)NULL);
+    AssertEqual(site->live, 10u);
+    AssertEqual(site->allocs, 10u);
+    AssertEqual(before.Find(site->origin, site->size), (const AllocSite*)NULL);
+    AssertEqual(after.Find(site->origin, site->size)->live, 0u);
+    AssertEqual(after.Find(site->origin, site->size)->allocs, 10u);
+
+    // the reported counts are scaled by the sample rate
+    char buf[1024];
+    format_write_info wi = { buf, buf + sizeof(buf) - 1 };
+    during.Report(format_output_mem, &wi, &before);
+    *wi.p = 0;
+    Assert(strstr(buf, "live 40 (+40) allocs 40 (+40)"));
+
+    wi = { buf, buf + sizeof(buf) - 1 };
+    after.Report(format_output_mem, &wi, &during);
+    *wi.p = 0;
+    Assert(strstr(buf, "live 0 (-40) allocs 40 (+0)"));
+}
+
+TEST_CASE("02 Sampled blocks reused")
+{
+    static AllocProfile before, after;
+
+    // blocks going back and forth through the pool are tracked only while live
+    before.Capture();
+    for (int i = 0; i < 1000; i++)
+    {
+        MemPoolFree(AllocBlock());
+    }
+    after.Capture();
+
+    char buf[1024];
+    format_write_info wi = { buf, buf + sizeof(buf) - 1 };
+    after.Report(format_output_mem, &wi, &before);
+    *wi.p = 0;
+    Assert(strstr(buf, "live 0 (+0) allocs 1000 (+1000)"));
+    AssertEqual(after.Dropped(), 0u);
+}
+
+}
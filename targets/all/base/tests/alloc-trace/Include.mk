@@ -0,0 +1,9 @@
+#
+# Copyright (c) 2026 triaxis s.r.o.
+# Licensed under the MIT license. See LICENSE.txt file in the repository root
+# for full license information.
+#
+# base/tests/alloc-trace/Include.mk
+#
+
+DEFINES += ALLOC_TRACE_PROFILE=1
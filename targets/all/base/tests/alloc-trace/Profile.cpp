@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/tests/alloc-trace/Profile.cpp
+ *
+ * Tests aggregation of traced allocations by origin
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/MemPool.h>
+#include <base/alloc_profile.h>
+
+namespace
+{
+
+typedef int8_t Block[MEMPOOL_GRANULARITY * 5];
+
+NO_INLINE Block* AllocBlock()
+{
+    return MemPoolAlloc<Block>();
+}
+
+const AllocSite* FindBySize(const AllocProfile& p, size_t size)
+{
+    for (auto& site: p)
+    {
+        if (site.size == size)
+            return &site;
+    }
+    return NULL;
+}
+
+TEST_CASE("01 Snapshot and diff")
+{
+    static AllocProfile before, during, after;
+
+    before.Capture();
+    Block* blocks[3];
+    for (auto& b: blocks)
+    {
+        b = AllocBlock();
+    }
+    during.Capture();
+    for (auto& b: blocks)
+    {
+        MemPoolFree(b);
+    }
+    after.Capture();
+
+    auto site = FindBySize(during, MemPoolSize<Block>());
+    AssertNotEqual(site, (const AllocSite*)NULL);
+    AssertEqual(site->live, 3u);
+    AssertEqual(site->allocs, 3u);
+    AssertEqual(before.Find(site->origin, site->size), (const AllocSite*)NULL);
+    AssertEqual(after.Find(site->origin, site->size)->live, 0u);
+    AssertEqual(after.Find(site->origin, site->size)->allocs, 3u);
+
+    char buf[1024];
+    format_write_info wi = { buf, buf + sizeof(buf) - 1 };
+    during.Report(format_output_mem, &wi, &before);
+    *wi.p = 0;
+    Assert(strstr(buf, "live 3 (+3) allocs 3 (+3)"));
+#if Thost
+    // origins are resolved to offsets within the test binary
+    Assert(strstr(buf, ".elf+0x"));
+#endif
+
+    wi = { buf, buf + sizeof(buf) - 1 };
+    after.Report(format_output_mem, &wi, &during);
+    *wi.p = 0;
+    Assert(strstr(buf, "live 0 (-3) allocs 3 (+0)"));
+}
+
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/tests/bench/MemPool.cpp
+ *
+ * Compares MemPool allocation patterns against the system allocator
+ *
+ * Each case adds a row per measurement to the result table, with the time
+ * per alloc/free pair in nanoseconds (not milliseconds) in the duration column
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/MemPool.h>
+#include <base/MemPoolAllocator.h>
+
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+// number of simultaneously live blocks
+constexpr size_t Live = 1024;
+// number of times the whole set is allocated and released
+constexpr size_t Rounds = 64;
+
+enum struct Order { LIFO, FIFO, Random };
+
+const char* const orderNames[] = { "LIFO", "FIFO", "random" };
+
+void* slots[Live];
+uint16_t order[Live];
+
+void PrepareOrder(Order o)
+{
+    for (size_t i = 0; i < Live; i++)
+    {
+        order[i] = o == Order::LIFO ? Live - 1 - i : i;
+    }
+
+    if (o == Order::Random)
+    {
+        uint32_t x = 0x12345678;
+        for (size_t i = Live - 1; i > 0; i--)
+        {
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            std::swap(order[i], order[x % (i + 1)]);
+        }
+    }
+}
+
+//! Measures the time per alloc/free pair in picoseconds, i.e. thousandths of the reported nanoseconds
+template<typename TAlloc, typename TFree> uint64_t Measure(TAlloc alloc, TFree release)
+{
+    auto t0 = MONO_US;
+    for (size_t r = 0; r < Rounds; r++)
+    {
+        for (size_t i = 0; i < Live; i++)
+        {
+            slots[i] = alloc();
+        }
+        for (size_t i = 0; i < Live; i++)
+        {
+            release(slots[order[i]]);
+        }
+    }
+    return uint64_t(MONO_US - t0) * 1000000 / (Live * Rounds);
+}
+
+template<size_t size> void BenchSize()
+{
+    for (auto o: { Order::LIFO, Order::FIFO, Order::Random })
+    {
+        PrepareOrder(o);
+        TestCase::ReportMetric(Measure(
+            [] { return MemPoolAlloc<size>(); },
+            [] (void* p) { MemPoolFree<size>(p); }),
+            "ns", "MemPoolAlloc %u B %s", unsigned(size), orderNames[int(o)]);
+        TestCase::ReportMetric(Measure(
+            [] { return MemPoolAllocDynamic<size>(); },
+            [] (void* p) { MemPoolFreeDynamic(p); }),
+            "ns", "MemPoolAllocDynamic %u B %s", unsigned(size), orderNames[int(o)]);
+        TestCase::ReportMetric(Measure(
+            [] { return calloc(1, size); },
+            [] (void* p) { free(p); }),
+            "ns", "malloc %u B %s", unsigned(size), orderNames[int(o)]);
+    }
+}
+
+TEST_CASE("01 Small blocks")
+{
+    BenchSize<16>();
+    BenchSize<64>();
+    BenchSize<MEMPOOL_MAX_SIZE>();
+}
+
+TEST_CASE("02 Extended size classes")
+{
+    BenchSize<MEMPOOL_MAX_SIZE + 1>();
+    BenchSize<MEMPOOL_EXT_MAX_SIZE>();
+}
+
+TEST_CASE("03 Large blocks")
+{
+    // above MEMPOOL_EXT_MAX_SIZE, this exercises MemPool::AllocLarge
+    BenchSize<MEMPOOL_EXT_MAX_SIZE * 2>();
+}
+
+//! Measures the time per inserted element in picoseconds, like Measure
+template<template<typename> class TAlloc> uint64_t MeasureContainers()
+{
+    auto t0 = MONO_US;
+    for (size_t r = 0; r < Rounds / 8; r++)
+    {
+        std::list<int, TAlloc<int>> list;
+        std::map<int, int, std::less<int>, TAlloc<std::pair<const int, int>>> map;
+        std::unordered_map<int, int, std::hash<int>, std::equal_to<int>, TAlloc<std::pair<const int, int>>> umap;
+        std::vector<int, TAlloc<int>> vec;
+
+        for (size_t i = 0; i < Live; i++)
+        {
+            list.push_back(i);
+            map[order[i]] = i;
+            umap[order[i]] = i;
+            vec.push_back(i);
+        }
+
+        AssertEqual(map.size(), Live);
+        AssertEqual(umap.size(), Live);
+    }
+    return uint64_t(MONO_US - t0) * 8 * 1000000 / (Live * Rounds);
+}
+
+TEST_CASE("04 Standard containers")
+{
+    PrepareOrder(Order::Random);
+    TestCase::ReportMetric(MeasureContainers<MemPoolAllocator>(), "ns", "MemPoolAllocator %u B random", unsigned(sizeof(int)));
+    TestCase::ReportMetric(MeasureContainers<std::allocator>(), "ns", "std::allocator %u B random", unsigned(sizeof(int)));
+}
+
+}
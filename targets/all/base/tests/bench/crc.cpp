@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * base/tests/bench/crc.cpp
+ *
+ * Compares the CRC implementations against a byte-at-a-time table loop
+ *
+ * Each case adds a row per measurement to the result table, with the
+ * throughput in bytes per CPU cycle (not milliseconds) in the duration column,
+ * or per tick of the fastest counter available on targets without a cycle counter
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/crc.h>
+
+#if defined(PLATFORM_CYCLE_COUNT)
+#define CYCLES()    PLATFORM_CYCLE_COUNT
+#define CYCLE_UNIT  "cycle"
+#elif __x86_64__ || __i386__
+#include <x86intrin.h>
+#define CYCLES()    __rdtsc()
+#define CYCLE_UNIT  "cycle"
+#elif __aarch64__
+// the generic timer is readable from user space, but runs much slower than the core
+#define CYCLES()    ({ uint64_t t; __asm__ volatile("isb; mrs %0, cntvct_el0" : "=r" (t)); t; })
+#define CYCLE_UNIT  "tick"
+#elif defined(MONO_US)
+// MONO_CLOCKS is virtual time in the host test runner, real microseconds are the next best thing
+#define CYCLES()    MONO_US
+#define CYCLE_UNIT  "us"
+#else
+#define CYCLES()    MONO_CLOCKS
+#define CYCLE_UNIT  "clock"
+#endif
+
+namespace
+{
+
+// total amount of data checksummed by each measurement
+constexpr size_t Total = 16 * 1024 * 1024;
+
+uint8_t data[65536];
+
+uint32_t table[256];
+// keeps the results observable, so that the calculations are not optimized away
+uint32_t results;
+
+// the loop the table-driven implementations replace
+uint32_t Bytewise(const void* p, size_t length, uint32_t crc)
+{
+    auto b = (const uint8_t*)p;
+    crc = ~crc;
+    while (length--)
+    {
+        crc = (crc >> 8) ^ table[(crc ^ *b++) & 0xFF];
+    }
+    return ~crc;
+}
+
+template<typename T> void Measure(const char* what, size_t block, T (*fn)(const void*, size_t, T))
+{
+    T crc = 0;
+    auto c0 = CYCLES();
+    for (size_t done = 0; done < Total; done += block)
+    {
+        // walk through the buffer, so that the blocks are not all served from L1
+        crc = fn(data + done % (sizeof(data) - block + 1), block, crc);
+    }
+    uint64_t cycles = CYCLES() - c0;
+    results += crc;
+
+    // thousandths of a byte per cycle (or whatever unit CYCLES() counts in)
+    TestCase::ReportMetric(uint64_t(Total) * 1000 / std::max(cycles, uint64_t(1)), "B/" CYCLE_UNIT, "%s %u B", what, unsigned(block));
+}
+
+TEST_CASE("01 Throughput")
+{
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = i * 2654435761u >> 24;
+    }
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        uint32_t crc = i;
+        for (int b = 0; b < 8; b++)
+            crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        table[i] = crc;
+    }
+
+    for (size_t block: { 64, 1500, 65536 })
+    {
+        Measure<uint32_t>("bytewise CRC32", block, Bytewise);
+        Measure<uint32_t>("CRC32", block, crc32);
+        Measure<uint32_t>("CRC32C", block, crc32c);
+        Measure<uint16_t>("CRC16 CCITT", block, crc16ccitt);
+        Measure<uint16_t>("CRC16 Modbus", block, crc16modbus);
+    }
+}
+
+}
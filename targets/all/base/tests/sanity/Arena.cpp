@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * Arena.cpp
+ *
+ * Tests the bump allocator
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/Arena.h>
+
+namespace   // prevent collisions
+{
+
+struct Pair { int a, b; };
+
+TEST_CASE("01 Arena alloc")
+{
+    Arena arena;
+
+    auto p1 = arena.New<Pair>();
+    AssertEqual(p1->a, 0);     // value-initialized
+    auto p2 = arena.New<Pair>(Pair{ 1, 2 });
+    AssertEqual(p2->b, 2);
+    // consecutive allocations are bumped in the same chunk
+    AssertEqual((char*)p2, (char*)(p1 + 1));
+
+    auto aligned = arena.Alloc(1, 64);
+    AssertEqual(uintptr_t(aligned) & 63, 0u);
+
+    auto arr = arena.NewArray<uint32_t>(10);
+    for (int i = 0; i < 10; i++)
+    {
+        AssertEqual(arr[i], 0u);
+    }
+
+    // oversized allocation gets its own chunk
+    auto large = arena.Alloc(ARENA_CHUNK_SIZE * 4);
+    AssertNotEqual(large, (void*)NULL);
+    memset(large, 0xAA, ARENA_CHUNK_SIZE * 4);
+}
+
+TEST_CASE("02 Arena checkpoints")
+{
+    Arena arena;
+
+    auto first = arena.New<Pair>();
+    auto mark = arena.Mark();
+    auto second = arena.New<Pair>();
+    for (int i = 0; i < 100; i++)
+    {
+        arena.New<Pair>();  // span multiple chunks
+    }
+    arena.Rewind(mark);
+    // memory after the mark is reused
+    AssertEqual(arena.New<Pair>(), second);
+
+    {
+        Arena::Scope scope(arena);
+        for (int i = 0; i < 100; i++)
+        {
+            arena.New<Pair>();
+        }
+    }
+    AssertEqual(arena.Mark().p, (char*)(second + 1));
+
+    arena.Reset();
+    // the first chunk is kept and reused
+    AssertEqual(arena.New<Pair>(), first);
+
+    arena.Release();
+    AssertEqual(arena.Mark().chunk, (ArenaChunk*)NULL);
+}
+
+}
@@ -0,0 +1,10 @@
+#
+# Copyright (c) 2026 triaxis s.r.o.
+# Licensed under the MIT license. See LICENSE.txt file in the repository root
+# for full license information.
+#
+# base/tests/sanity/Include.mk
+#
+
+# make sure optional MemPool statistics are compiled and tested
+DEFINES += MEMPOOL_STATS=1
@@ -16,6 +16,11 @@
 #include <testrunner/TestCase.h>
 
 #include <base/MemPool.h>
+#include <base/format.h>
+#include <base/MemPoolAllocator.h>
+
+#include <map>
+#include <vector>
 
 namespace   // prevent collisions
 {
@@ -30,7 +35,7 @@ TEST_CASE("01 Fixed alloc")
     AssertEqual(mem, mem2); // same block must be returned immediately after freeing
     MemPoolFree(mem2);
 
-    auto memLarge = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    auto memLarge = MemPoolAlloc<int8_t[MEMPOOL_EXT_MAX_SIZE * 2]>();
     MemPoolFree(memLarge);
 }
 
@@ -39,7 +44,7 @@ TEST_CASE("02 Dynamic alloc")
     int* mem = MemPoolAllocDynamic<int>();
     MemPoolFreeDynamic(mem);
 
-    auto mem2 = MemPoolAllocDynamic<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    auto mem2 = MemPoolAllocDynamic<int8_t[MEMPOOL_EXT_MAX_SIZE * 2]>();
     MemPoolFreeDynamic(mem2);
 }
 
@@ -47,10 +52,101 @@ TEST_CASE("03 MemPoolGet")
 {
     // maximum size MemPool must still be available
     AssertNotEqual(MemPoolGet<MEMPOOL_MAX_SIZE>(), (MemPool*)NULL);
+    // maximum size extended MemPool must still be available
+    AssertNotEqual(MemPoolGet<MEMPOOL_EXT_MAX_SIZE>(), (MemPool*)NULL);
     // size above maximum must not be available
-    AssertEqual(MemPoolGet<MEMPOOL_MAX_SIZE * 2>(), (MemPool*)NULL);
+    AssertEqual(MemPoolGet<MEMPOOL_EXT_MAX_SIZE * 2>(), (MemPool*)NULL);
     // check smallest possible mempool
     AssertEqual(MemPoolGet<1>(), MemPoolGet<MEMPOOL_MIN_SIZE>());
 }
 
+TEST_CASE("04 Extended sizes")
+{
+    // extended sizes grow in MEMPOOL_EXT_STEPS steps per doubling
+    constexpr size_t step = MEMPOOL_MAX_SIZE / MEMPOOL_EXT_STEPS;
+    AssertEqual(MemPoolSize<MEMPOOL_MAX_SIZE + 1>(), MEMPOOL_MAX_SIZE + step);
+    AssertEqual(MemPoolSize<MEMPOOL_MAX_SIZE + step>(), MEMPOOL_MAX_SIZE + step);
+    AssertEqual(MemPoolSize<MEMPOOL_MAX_SIZE * 2 + 1>(), MEMPOOL_MAX_SIZE * 2 + step * 2);
+    AssertEqual(MemPoolSize<MEMPOOL_EXT_MAX_SIZE>(), size_t(MEMPOOL_EXT_MAX_SIZE));
+    AssertEqual(MemPoolSize<MEMPOOL_EXT_MAX_SIZE + 1>(), 0u);
+    AssertEqual(MemPoolGet<MEMPOOL_MAX_SIZE + 1>(), MemPoolGet<MEMPOOL_MAX_SIZE + step>());
+
+    auto mem = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    Assert(Span(mem, sizeof(*mem)).IsAllZeroes());
+    MemPoolFree(mem);
+    auto mem2 = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    AssertEqual(mem, mem2); // extended pools recycle blocks the same way
+    MemPoolFree(mem2);
+
+    auto dyn = MemPoolAllocDynamic<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    MemPoolFreeDynamic(dyn);
+    auto dyn2 = MemPoolAllocDynamic<int8_t[MEMPOOL_MAX_SIZE * 2]>();
+    AssertEqual(dyn, dyn2); // dynamically freed block must return to its pool
+    MemPoolFreeDynamic(dyn2);
+}
+
+#if MEMPOOL_STATS
+TEST_CASE("05 Statistics")
+{
+    auto pool = MemPoolGet<int8_t[MEMPOOL_MAX_SIZE * 3]>();
+    auto before = pool->Stats();
+
+    auto mem1 = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 3]>();
+    auto mem2 = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 3]>();
+    MemPoolFree(mem1);
+    MemPoolFree(mem2);
+    mem1 = MemPoolAlloc<int8_t[MEMPOOL_MAX_SIZE * 3]>();
+
+    auto s = pool->Stats();
+    AssertEqual(s.size, uint32_t(MemPoolSize<MEMPOOL_MAX_SIZE * 3>()));
+    AssertEqual(s.allocs - before.allocs, 3u);
+    AssertEqual(s.frees - before.frees, 2u);
+    AssertEqual(s.live - before.live, 1u);
+    AssertGreaterOrEqual(s.peak, before.live + 2);
+    AssertEqual(s.live + s.free, s.refills);
+
+    // the pool must be registered after its first use
+    bool found = false;
+    for (auto p = MemPool::First(); p; p = p->Next())
+    {
+        found |= p == pool;
+    }
+    Assert(found);
+
+    // binary dump reports the required size even if the buffer is too small
+    size_t len = MemPool::DumpBinary(NULL, 0);
+    AssertGreaterOrEqual(len, sizeof(MemPoolStats));
+    AssertEqual(len % sizeof(MemPoolStats), 0u);
+
+    char json[2048];
+    format_write_info wi = { json, json + sizeof(json) - 1 };
+    MemPool::DumpJson(format_output_mem, &wi);
+    *wi.p = 0;
+    AssertEqual(json[0], '[');
+    Assert(strstr(json, "\"refills\":"));
+
+    MemPoolFree(mem1);
+}
+#endif
+
+TEST_CASE("06 STL allocator")
+{
+    std::map<int, int, std::less<int>, MemPoolAllocator<std::pair<const int, int>>> map;
+    std::vector<int, MemPoolAllocator<int>> vec;
+
+    for (int i = 0; i < 100; i++)
+    {
+        map[i] = i * 2;
+        vec.push_back(i);
+    }
+
+    AssertEqual(map.size(), 100u);
+    AssertEqual(map[50], 100);
+    AssertEqual(vec[99], 99);
+
+    map.clear();
+    vec.clear();
+    vec.shrink_to_fit();
+}
+
 }
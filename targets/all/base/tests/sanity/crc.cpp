@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * crc.cpp
+ *
+ * Compares the table-driven and hardware CRCs against bitwise calculations
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/crc.h>
+
+namespace
+{
+
+uint8_t data[300];
+
+void Fill(uint32_t seed)
+{
+    for (auto& b: data)
+    {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        b = seed;
+    }
+}
+
+uint32_t BitwiseReflected(const uint8_t* p, size_t length, uint32_t crc, uint32_t poly)
+{
+    while (length--)
+    {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++)
+            crc = crc & 1 ? (crc >> 1) ^ poly : crc >> 1;
+    }
+    return crc;
+}
+
+uint16_t BitwiseNormal16(const uint8_t* p, size_t length, uint16_t crc, uint16_t poly)
+{
+    while (length--)
+    {
+        crc ^= *p++ << 8;
+        for (int b = 0; b < 8; b++)
+            crc = crc & 0x8000 ? (crc << 1) ^ poly : crc << 1;
+    }
+    return crc;
+}
+
+TEST_CASE("01 Check Values")
+{
+    Span check = "123456789";
+    AssertEqual(crc32(check), 0xCBF43926u);
+    AssertEqual(crc32c(check), 0xE3069283u);
+    AssertEqual(crc16ccitt(check), 0x29B1);
+    AssertEqual(CRC16XModem().Update(check).Value(), 0x31C3);
+    AssertEqual(crc16modbus(check), 0x4B37);
+}
+
+TEST_CASE("02 Bitwise")
+{
+    for (uint32_t seed = 1; seed < 10; seed++)
+    {
+        Fill(seed);
+        for (size_t start = 0; start < 8; start++)
+        {
+            for (size_t length = 0; length + start <= sizeof(data); length += 1 + length / 8)
+            {
+                const uint8_t* p = data + start;
+                AssertEqual(crc32(p, length), ~BitwiseReflected(p, length, ~0u, 0xEDB88320u));
+                AssertEqual(crc32c(p, length), ~BitwiseReflected(p, length, ~0u, 0x82F63B78u));
+                AssertEqual(crc16ccitt(p, length), BitwiseNormal16(p, length, 0xFFFF, 0x1021));
+                AssertEqual(crc16modbus(p, length), uint16_t(BitwiseReflected(p, length, 0xFFFF, 0xA001)));
+            }
+        }
+    }
+}
+
+TEST_CASE("03 Incremental")
+{
+    Fill(42);
+    uint32_t whole32 = crc32(data, sizeof(data));
+    uint32_t whole32c = crc32c(data, sizeof(data));
+    uint16_t whole16 = crc16ccitt(data, sizeof(data));
+    uint16_t wholeModbus = crc16modbus(data, sizeof(data));
+
+    for (size_t split = 0; split <= sizeof(data); split++)
+    {
+        AssertEqual(crc32(data + split, sizeof(data) - split, crc32(data, split)), whole32);
+        AssertEqual(crc32c(data + split, sizeof(data) - split, crc32c(data, split)), whole32c);
+        AssertEqual(crc16ccitt(data + split, sizeof(data) - split, crc16ccitt(data, split)), whole16);
+        AssertEqual(crc16modbus(data + split, sizeof(data) - split, crc16modbus(data, split)), wholeModbus);
+    }
+
+    // segments of varying sizes, as enumerated from a pipe
+    Span spans[] = { Span(data, 1), Span(data + 1, 31), Span(data + 32, 100), Span(data + 132, size_t(0)), Span(data + 132, 168) };
+    AssertEqual(CRC32().UpdateSpans(spans).Value(), whole32);
+    AssertEqual(CRC32C().UpdateSpans(spans).Value(), whole32c);
+    AssertEqual(CRC16CCITT().UpdateSpans(spans).Value(), whole16);
+    AssertEqual(CRC16Modbus().UpdateSpans(spans).Value(), wholeModbus);
+}
+
+}
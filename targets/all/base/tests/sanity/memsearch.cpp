@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * memsearch.cpp
+ *
+ * Compares the vectorized searches against naive loops
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <base/memsearch.h>
+
+namespace
+{
+
+uint8_t data[300];
+
+// a small alphabet produces plenty of partial matches
+void Fill(uint32_t seed)
+{
+    for (auto& b: data)
+    {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;
+        b = 'a' + seed % 4;
+    }
+}
+
+const void* NaiveSearch(const uint8_t* p, size_t length, const uint8_t* needle, size_t n)
+{
+    for (size_t i = 0; i + n <= length; i++)
+    {
+        if (!memcmp(p + i, needle, n))
+            return p + i;
+    }
+    return NULL;
+}
+
+const void* NaiveFindAny(const uint8_t* p, size_t length, const uint8_t* set, size_t n)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (memchr(set, p[i], n))
+            return p + i;
+    }
+    return NULL;
+}
+
+const void* NaiveSkipAny(const uint8_t* p, size_t length, const uint8_t* set, size_t n)
+{
+    for (size_t i = 0; i < length; i++)
+    {
+        if (!memchr(set, p[i], n))
+            return p + i;
+    }
+    return NULL;
+}
+
+TEST_CASE("01 Search")
+{
+    for (uint32_t seed = 1; seed < 40; seed++)
+    {
+        Fill(seed);
+        for (size_t start = 0; start < 8; start++)
+        {
+            for (size_t n = 1; n < 40; n += 3)
+            {
+                // needles taken from the data as well as ones that are likely missing
+                const uint8_t* needle = data + (seed * 37) % (sizeof(data) - n);
+                AssertEqual(memsearch(data + start, sizeof(data) - start, needle, n), NaiveSearch(data + start, sizeof(data) - start, needle, n));
+                uint8_t missing[40];
+                memcpy(missing, needle, n);
+                missing[n / 2] = 'e';
+                AssertEqual(memsearch(data + start, sizeof(data) - start, missing, n), NaiveSearch(data + start, sizeof(data) - start, missing, n));
+            }
+        }
+    }
+
+    // needle at the very end, and degenerate cases
+    Fill(1);
+    AssertEqual(memsearch(data, sizeof(data), data + sizeof(data) - 17, 17), NaiveSearch(data, sizeof(data), data + sizeof(data) - 17, 17));
+    AssertEqual(memsearch(data, 10, data, 0), (const void*)data);
+    AssertEqual(memsearch(data, 3, "abcd", 4), (const void*)NULL);
+}
+
+TEST_CASE("02 Find Any")
+{
+    static const uint8_t sets[] = "\xFF" "edcba";
+    for (uint32_t seed = 1; seed < 40; seed++)
+    {
+        Fill(seed);
+        // make the matches rare, so most of the data is skipped
+        for (size_t i = 0; i < sizeof(data); i++)
+        {
+            if (data[i] == 'a' && (i + seed) % 7)
+                data[i] = 'x';
+        }
+
+        for (size_t start = 0; start < 8; start++)
+        {
+            for (size_t n = 0; n <= 6; n++)
+            {
+                AssertEqual(memfindany(data + start, sizeof(data) - start, sets, n), NaiveFindAny(data + start, sizeof(data) - start, sets, n));
+            }
+
+            // large sets use the lookup table
+            uint8_t large[20] = "0123456789ABCDEFGHa";
+            AssertEqual(memfindany(data + start, sizeof(data) - start, large, 19), NaiveFindAny(data + start, sizeof(data) - start, large, 19));
+        }
+    }
+}
+
+TEST_CASE("03 Skip Any")
+{
+    static const uint8_t sets[] = "abcd" "0123456789ABCDEF";
+    for (uint32_t seed = 1; seed < 40; seed++)
+    {
+        Fill(seed);
+        // long runs of set bytes, broken by an occasional outsider
+        for (size_t i = 0; i < sizeof(data); i++)
+        {
+            if (i % 97 == seed % 97)
+                data[i] = 'x';
+        }
+
+        for (size_t start = 0; start < 8; start++)
+        {
+            for (size_t n = 0; n <= 8; n++)
+            {
+                AssertEqual(memskipany(data + start, sizeof(data) - start, sets, n), NaiveSkipAny(data + start, sizeof(data) - start, sets, n));
+            }
+
+            // large sets use the lookup table
+            AssertEqual(memskipany(data + start, sizeof(data) - start, sets, 20), NaiveSkipAny(data + start, sizeof(data) - start, sets, 20));
+        }
+    }
+
+    // no byte outside the set
+    Fill(1);
+    AssertEqual(memskipany(data, sizeof(data), "abcd", 4), (const void*)NULL);
+}
+
+TEST_CASE("04 Count")
+{
+    for (uint32_t seed = 1; seed < 40; seed++)
+    {
+        Fill(seed);
+        for (size_t start = 0; start < 8; start++)
+        {
+            for (uint8_t value: { 'a', 'd', 'x' })
+            {
+                size_t n = 0;
+                for (size_t i = start; i < sizeof(data); i++)
+                {
+                    n += data[i] == value;
+                }
+                AssertEqual(memcount(data + start, sizeof(data) - start, value), n);
+            }
+        }
+    }
+}
+
+}
@@ -10,4 +10,6 @@
 
 DEFINE_EXCEPTION(io::TimeoutError);
 DEFINE_EXCEPTION(io::AbortError);
+DEFINE_EXCEPTION(io::IOError);
+DEFINE_EXCEPTION(io::FormatError);
 
@@ -15,5 +15,9 @@ namespace io
 
 DECLARE_EXCEPTION(TimeoutError);
 DECLARE_EXCEPTION(AbortError);
+//! Failure reported by the underlying system, the value is the negated errno where available
+DECLARE_EXCEPTION(IOError);
+//! Malformed data encountered while decoding a stream
+DECLARE_EXCEPTION(FormatError);
 
 }
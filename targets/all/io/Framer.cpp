@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Framer.cpp
+ */
+
+#include <io/Framer.h>
+
+#include <io/Errors.h>
+
+namespace io
+{
+
+namespace
+{
+
+// the longest COBS block, consisting of the code byte and 254 data bytes
+constexpr size_t CobsBlock = 255;
+// a varint longer than this would not fit in 32 bits
+constexpr int MaxVarint = 5;
+
+// bytes removed from the stream by the encodings, handed out as spans of their own
+const uint8_t s_zero = 0;
+const uint8_t s_end = SlipFramer::End;
+const uint8_t s_esc = SlipFramer::Esc;
+
+}
+
+size_t Framer::Scan(uint8_t delimiter)
+{
+    size_t available = input.Available();
+    if (scanned >= available)
+    {
+        return 0;
+    }
+
+    for (Span s: (input.Enumerate(available) + scanned).Spans())
+    {
+        if (auto p = (const char*)memchr(s.Pointer(), delimiter, s.Length()))
+        {
+            size_t n = scanned + (p - s.Pointer()) + 1;
+            scanned = 0;
+            return n;
+        }
+        scanned += s.Length();
+    }
+    return 0;
+}
+
+async(Framer::FindDelimiter, uint8_t delimiter, Timeout timeout)
+async_def(
+    Timeout timeout;
+    size_t available;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    for (;;)
+    {
+        if (size_t n = Scan(delimiter))
+        {
+            if (!skipping && n <= maxLength + 1)
+            {
+                size = n;
+                async_return(true);
+            }
+
+            // the end of the frame that was too long
+            input.Advance(n);
+            if (!skipping)
+            {
+                async_throw(FormatError, 0);
+            }
+            skipping = false;
+            continue;
+        }
+
+        if (skipping || scanned > maxLength)
+        {
+            // the rest of the frame is not needed
+            input.Advance(scanned);
+            scanned = 0;
+            if (!skipping)
+            {
+                skipping = true;
+                async_throw(FormatError, 0);
+            }
+        }
+
+        f.available = input.Available();
+        if (size_t(await(input.Require, f.available + 1, f.timeout)) <= f.available)
+        {
+            // the input completed without a delimiter
+            input.Advance(f.available);
+            scanned = 0;
+            if (f.available && !skipping)
+            {
+                async_throw(FormatError, f.available);
+            }
+            skipping = false;
+            async_return(false);
+        }
+    }
+}
+async_end
+
+async(Framer::Reserve, PipeWriter output, PipePosition publish, size_t hint, Timeout timeout)
+{
+    if (!output.CanAllocate())
+    {
+        // let the reader make room in the pipe
+        if (size_t n = output.Position().LengthUntil(publish))
+        {
+            output.Advance(n);
+        }
+    }
+    return async_forward(output.Allocate, hint, timeout);
+}
+
+size_t Framer::Put(PipeWriter output, PipePosition position, Span data)
+{
+    size_t n = 0;
+    while (n < data.Length())
+    {
+        auto buf = output.GetBufferAt(position + n);
+        if (!buf.Length())
+        {
+            break;
+        }
+        size_t block = std::min(buf.Length(), data.Length() - n);
+        memcpy(buf.Pointer(), data.Pointer() + n, block);
+        n += block;
+    }
+    return n;
+}
+
+async(Framer::Fill, PipeWriter output, PipePosition position, Span data, PipePosition publish, Timeout timeout)
+async_def(
+    size_t written;
+)
+{
+    while ((f.written += Put(output, position + f.written, data.RemoveLeft(f.written))) < data.Length())
+    {
+        // only the data already filled in can be published
+        await(Reserve, output, std::min(publish, position + f.written), data.Length() - f.written, timeout);
+    }
+}
+async_end
+
+int VarintFramer::ParseHeader()
+{
+    if (!input.Available())
+    {
+        return 0;
+    }
+
+    // the prefix ends with the first byte without the continuation bit
+    size_t value = 0;
+    int n = 0;
+    for (auto it = input.Enumerate(MaxVarint); it; n++)
+    {
+        uint8_t b = it.Read();
+        value |= size_t(b & 0x7F) << (7 * n);
+        if (!(b & 0x80))
+        {
+            length = value;
+            return n + 1;
+        }
+    }
+    return n == MaxVarint ? -1 : 0;
+}
+
+async(VarintFramer::Next, Timeout timeout)
+async_def(
+    Timeout timeout;
+    int header;
+    size_t available;
+)
+{
+    Advance();
+    f.timeout = timeout.MakeAbsolute();
+
+    while (!(f.header = ParseHeader()))
+    {
+        f.available = input.Available();
+        if (size_t(await(input.Require, f.available + 1, f.timeout)) <= f.available)
+        {
+            if (!f.available)
+            {
+                async_return(false);
+            }
+            // truncated in the middle of the length
+            async_throw(FormatError, f.available);
+        }
+    }
+
+    if (f.header < 0 || length > maxLength)
+    {
+        length = 0;
+        async_throw(FormatError, 0);
+    }
+
+    // the whole frame at once
+    if (size_t(await(input.Require, f.header + length, f.timeout)) < f.header + length)
+    {
+        length = 0;
+        async_throw(FormatError, input.Available());
+    }
+
+    size = f.header + length;
+    async_return(true);
+}
+async_end
+
+async(VarintFramer::Write, PipeWriter output, Span payload, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipePosition pos;
+    uint8_t header[MaxVarint];
+    size_t headerLength;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    for (size_t n = payload.Length(); ; n >>= 7)
+    {
+        f.header[f.headerLength++] = (n & 0x7F) | (n >= 0x80 ? 0x80 : 0);
+        if (n < 0x80)
+        {
+            break;
+        }
+    }
+
+    f.pos = output.Position();
+    await(Fill, output, f.pos, Span(f.header, f.headerLength), f.pos + f.headerLength, f.timeout);
+    await(Fill, output, f.pos + f.headerLength, payload, f.pos + f.headerLength + payload.Length(), f.timeout);
+    output.Advance(output.Position().LengthUntil(f.pos + f.headerLength + payload.Length()));
+}
+async_end
+
+async(HeaderFramer::Next, Timeout timeout)
+async_def(
+    Timeout timeout;
+    size_t available;
+)
+{
+    Advance();
+    f.timeout = timeout.MakeAbsolute();
+
+    f.available = await(input.Require, headerLength, f.timeout);
+    if (f.available < headerLength)
+    {
+        if (!f.available)
+        {
+            async_return(false);
+        }
+        async_throw(FormatError, f.available);
+    }
+
+    uint8_t field[4];
+    input.Peek(Buffer(field, lengthSize), lengthOffset);
+    length = 0;
+    for (size_t i = 0; i < lengthSize; i++)
+    {
+        length |= size_t(field[bigEndian ? i : lengthSize - 1 - i]) << (8 * (lengthSize - 1 - i));
+    }
+
+    if (length > maxLength)
+    {
+        length = 0;
+        async_throw(FormatError, 0);
+    }
+
+    // the whole frame at once
+    if (size_t(await(input.Require, headerLength + length, f.timeout)) < headerLength + length)
+    {
+        length = 0;
+        async_throw(FormatError, input.Available());
+    }
+
+    size = headerLength + length;
+    async_return(true);
+}
+async_end
+
+async(HeaderFramer::Write, PipeWriter output, Span header, Span payload, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipePosition pos;
+)
+{
+    ASSERT(header.Length() == headerLength);
+    if (uint64_t(payload.Length()) >> (8 * lengthSize))
+    {
+        async_throw(FormatError, payload.Length());
+    }
+    f.timeout = timeout.MakeAbsolute();
+
+    // the header stays unpublished until its length field is filled in
+    f.pos = output.Position();
+    await(Fill, output, f.pos, header, f.pos, f.timeout);
+
+    uint8_t field[4];
+    for (size_t i = 0; i < lengthSize; i++)
+    {
+        field[bigEndian ? i : lengthSize - 1 - i] = payload.Length() >> (8 * (lengthSize - 1 - i));
+    }
+    Put(output, f.pos + lengthOffset, Span(field, lengthSize));
+
+    await(Fill, output, f.pos + headerLength, payload, f.pos + headerLength + payload.Length(), f.timeout);
+    output.Advance(output.Position().LengthUntil(f.pos + headerLength + payload.Length()));
+}
+async_end
+
+bool CobsFramer::Validate()
+{
+    // each block consists of a code byte and code - 1 data bytes, all blocks
+    // but the last one and those of the maximum length are followed by a zero
+    length = 0;
+    for (auto it = input.Enumerate(size - 1); it;)
+    {
+        uint8_t code = it.Read();
+        if (size_t(code - 1) > it.Available())
+        {
+            return false;
+        }
+        it.Skip(code - 1);
+        length += code - 1 + (it && code != CobsBlock);
+    }
+    return true;
+}
+
+void CobsFramer::SpanIterator::Load()
+{
+    while (remaining)
+    {
+        if (run)
+        {
+            span = (*it.Spans()).Left(run);
+            it.Skip(span.Length());
+            run -= span.Length();
+            return;
+        }
+
+        if (zero)
+        {
+            zero = false;
+            span = Span(&s_zero, 1);
+            return;
+        }
+
+        uint8_t code = it.Read();
+        run = code - 1;
+        zero = code != CobsBlock;
+    }
+}
+
+async(CobsFramer::Next, Timeout timeout)
+async_def(
+    Timeout timeout;
+)
+{
+    Advance();
+    f.timeout = timeout.MakeAbsolute();
+
+    while (await(FindDelimiter, 0, f.timeout))
+    {
+        if (size == 1)
+        {
+            // consecutive delimiters do not form a frame
+            Advance();
+            continue;
+        }
+
+        if (!Validate())
+        {
+            Advance();
+            async_throw(FormatError, 0);
+        }
+
+        async_return(true);
+    }
+
+    async_return(false);
+}
+async_end
+
+async(CobsFramer::Write, PipeWriter output, Span payload, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipePosition code, fill;
+    size_t in;
+    uint8_t run;
+    bool open;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+    f.code = f.fill = output.Position();
+
+    for (;;)
+    {
+        // the block being encoded stays unpublished until its code byte is filled in
+        if (!output.AvailableAfter(f.fill))
+        {
+            await(Reserve, output, f.code, payload.Length() - f.in + CobsBlock - f.run + 1, f.timeout);
+            continue;
+        }
+
+        if (!f.open)
+        {
+            // room for the code byte
+            f.code = f.fill;
+            f.fill += 1;
+            f.run = 0;
+            f.open = true;
+            continue;
+        }
+
+        if (f.in < payload.Length() && f.run < CobsBlock - 1 && payload[f.in])
+        {
+            // copy non-zero data up to the next zero or the end of the block
+            size_t n = std::min(payload.Length() - f.in, CobsBlock - 1 - f.run);
+            if (auto p = (const char*)memchr(payload.Pointer() + f.in, 0, n))
+            {
+                n = p - (payload.Pointer() + f.in);
+            }
+            n = Put(output, f.fill, Span(payload.Pointer() + f.in, n));
+            f.fill += n;
+            f.in += n;
+            f.run += n;
+            continue;
+        }
+
+        // the block ends with a zero, with the payload or when it is full
+        uint8_t code = f.run + 1;
+        Put(output, f.code, Span(&code, 1));
+        f.open = false;
+
+        if (f.in == payload.Length())
+        {
+            // the frame delimiter, there is room for it
+            Put(output, f.fill, Span(&s_zero, 1));
+            f.fill += 1;
+            break;
+        }
+
+        if (code != CobsBlock)
+        {
+            // the zero is implied by the code
+            f.in++;
+        }
+    }
+
+    output.Advance(output.Position().LengthUntil(f.fill));
+}
+async_end
+
+bool SlipFramer::Validate()
+{
+    // every escape must be followed by one of the escaped codes
+    size_t escapes = 0;
+    bool escaped = false;
+    for (Span s: input.EnumerateSpans(size - 1))
+    {
+        auto p = (const uint8_t*)s.Pointer();
+        auto e = p + s.Length();
+        if (escaped)
+        {
+            if (*p != EscEnd && *p != EscEsc)
+            {
+                return false;
+            }
+            p++;
+            escaped = false;
+        }
+
+        while ((p = (const uint8_t*)memchr(p, Esc, e - p)))
+        {
+            escapes++;
+            if (++p == e)
+            {
+                escaped = true;
+                break;
+            }
+            if (*p != EscEnd && *p != EscEsc)
+            {
+                return false;
+            }
+            p++;
+        }
+    }
+
+    length = size - 1 - escapes;
+    return !escaped;
+}
+
+void SlipFramer::SpanIterator::Load()
+{
+    if (!remaining)
+    {
+        return;
+    }
+
+    if (*it == char(Esc))
+    {
+        ++it;
+        span = Span(uint8_t(it.Read()) == EscEnd ? &s_end : &s_esc, 1);
+        return;
+    }
+
+    span = *it.Spans();
+    if (auto p = (const char*)memchr(span.Pointer(), Esc, span.Length()))
+    {
+        span = span.Left(p - span.Pointer());
+    }
+    it.Skip(span.Length());
+}
+
+async(SlipFramer::Next, Timeout timeout)
+async_def(
+    Timeout timeout;
+)
+{
+    Advance();
+    f.timeout = timeout.MakeAbsolute();
+
+    while (await(FindDelimiter, End, f.timeout))
+    {
+        if (size == 1)
+        {
+            // consecutive END bytes do not form a frame
+            Advance();
+            continue;
+        }
+
+        if (!Validate())
+        {
+            Advance();
+            async_throw(FormatError, 0);
+        }
+
+        async_return(true);
+    }
+
+    async_return(false);
+}
+async_end
+
+async(SlipFramer::Write, PipeWriter output, Span payload, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipePosition fill;
+    size_t in;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+    f.fill = output.Position();
+
+    // the leading END, payload and the trailing END
+    while (f.in <= payload.Length() + 1)
+    {
+        // room for an escape sequence
+        if (output.AvailableAfter(f.fill) < 2)
+        {
+            await(Reserve, output, f.fill, payload.Length() - f.in + 2, f.timeout);
+            continue;
+        }
+
+        if (!f.in || f.in == payload.Length() + 1)
+        {
+            Put(output, f.fill, Span(&s_end, 1));
+            f.fill += 1;
+            f.in++;
+            continue;
+        }
+
+        uint8_t b = payload[f.in - 1];
+        if (b == End || b == Esc)
+        {
+            uint8_t esc[] = { Esc, b == End ? EscEnd : EscEsc };
+            Put(output, f.fill, Span(esc, 2));
+            f.fill += 2;
+            f.in++;
+            continue;
+        }
+
+        // copy the data up to the next byte that needs escaping
+        size_t n = 1;
+        while (f.in - 1 + n < payload.Length() && uint8_t(payload[f.in - 1 + n]) != End && uint8_t(payload[f.in - 1 + n]) != Esc)
+        {
+            n++;
+        }
+        n = Put(output, f.fill, Span(payload.Pointer() + f.in - 1, n));
+        f.fill += n;
+        f.in += n;
+    }
+
+    output.Advance(output.Position().LengthUntil(f.fill));
+}
+async_end
+
+}
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Framer.h
+ *
+ * Readers and writers of message frames carried over pipes, for the common
+ * ways of delimiting messages in a byte stream: a varint length prefix,
+ * a fixed header with a length field, COBS and SLIP.
+ *
+ * A framer waits for a complete frame and leaves it in the input pipe,
+ * handing it out as a sequence of spans pointing into the pipe segments;
+ * the input is advanced past the frame when the next one is requested.
+ * Length-prefixed frames are awaited with a single Require of the header
+ * and payload, delimited frames by scanning only the newly arrived data.
+ * The frame must fit in the input pipe, i.e. the level to which it has to
+ * drain before a throttled writer resumes must be above the maximum frame
+ * length, otherwise the writer would wait forever.
+ *
+ * The writers build the frame in place in the allocated space of the output
+ * pipe and publish it to the reader at once, unless the pipe throttles
+ * the writer before the frame is complete.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+//! Default maximum length of a frame, see the individual framers for what it applies to
+#ifndef FRAMER_MAX_LENGTH
+#define FRAMER_MAX_LENGTH   1024
+#endif
+
+namespace io
+{
+
+//! Common state of the frame readers
+class Framer
+{
+public:
+    //! Gets the length of the payload of the current frame
+    size_t Length() const { return length; }
+    //! Advances the input past the current frame, releasing the spans handed out for it
+    void Advance() { if (size) { input.Advance(size); size = length = 0; } }
+
+protected:
+    Framer(PipeReader input, size_t maxLength)
+        : input(input), maxLength(maxLength) {}
+
+    PipeReader input;
+    size_t maxLength;
+    size_t length = 0;      //!< Length of the payload of the current frame
+    size_t size = 0;        //!< Bytes occupied by the current frame in the input, including the header or delimiter
+    size_t scanned = 0;     //!< Bytes after the current frame already searched for a delimiter
+    bool skipping = false;  //!< Discarding input until the next delimiter after a frame that was too long
+
+    //! Gets the spans of @p length bytes of the current frame at @p offset
+    Pipe::SpanIterator Spans(size_t offset, size_t length) const { return length ? (input.Enumerate(offset + length) + offset).Spans() : Pipe::SpanIterator(); }
+
+    //! Waits for a frame ending with the @p delimiter byte, setting its size including the delimiter
+    //! @returns false if the input completes first
+    //! Throws FormatError when discarding a frame longer than the maximum length or cut off by the end of the input
+    async(FindDelimiter, uint8_t delimiter, Timeout timeout);
+    //! Searches the newly available data for the delimiter
+    //! @returns the size of the frame including the delimiter, zero if there is none yet
+    size_t Scan(uint8_t delimiter);
+
+    //! Makes room for more of a frame being written in place, publishing the data before @p publish
+    //! first if the writer would have to wait for the reader
+    static async(Reserve, PipeWriter output, PipePosition publish, size_t hint, Timeout timeout);
+    //! Copies data to the allocated space of the output at @p position
+    //! @returns the number of bytes that fit
+    static size_t Put(PipeWriter output, PipePosition position, Span data);
+    //! Copies data to the output at @p position, allocating space as needed
+    //! Data before @p publish may be published to the reader in the meantime
+    static async(Fill, PipeWriter output, PipePosition position, Span data, PipePosition publish, Timeout timeout);
+};
+
+//! Frames prefixed by the payload length as an unsigned LEB128 varint (as used by protobuf)
+class VarintFramer : public Framer
+{
+public:
+    //! Creates a framer reading from @p input, rejecting payloads longer than @p maxLength
+    VarintFramer(PipeReader input, size_t maxLength = FRAMER_MAX_LENGTH)
+        : Framer(input, maxLength) {}
+
+    //! Advances past the current frame and waits for the next complete one
+    //! @returns true when a frame is available, false if the input completes
+    //! Throws FormatError if the frame is too long or truncated, the stream cannot be resynchronized after that
+    async(Next, Timeout timeout = Timeout::Infinite);
+    //! Gets the payload of the current frame
+    Pipe::SpanIterator Frame() const { return Spans(size - length, length); }
+
+    //! Writes a frame with the specified payload
+    static async(Write, PipeWriter output, Span payload, Timeout timeout = Timeout::Infinite);
+
+private:
+    //! Decodes the length prefix from the available data
+    //! @returns the length of the prefix, zero if more data is needed, -1 if it is malformed
+    int ParseHeader();
+};
+
+//! Frames starting with a fixed-size header containing an unsigned payload length field
+class HeaderFramer : public Framer
+{
+public:
+    //! Creates a framer for headers of @p headerLength bytes with a length field of @p lengthSize (1, 2 or 4) bytes at @p lengthOffset
+    HeaderFramer(PipeReader input, size_t headerLength, size_t lengthOffset, size_t lengthSize, bool bigEndian = true, size_t maxLength = FRAMER_MAX_LENGTH)
+        : Framer(input, maxLength), headerLength(headerLength), lengthOffset(lengthOffset), lengthSize(lengthSize), bigEndian(bigEndian)
+    {
+        ASSERT(headerLength <= 255);
+        ASSERT(lengthSize == 1 || lengthSize == 2 || lengthSize == 4);
+        ASSERT(lengthOffset + lengthSize <= headerLength);
+    }
+
+    //! Advances past the current frame and waits for the next complete one
+    //! @returns true when a frame is available, false if the input completes
+    //! Throws FormatError if the frame is too long or truncated, the stream cannot be resynchronized after that
+    async(Next, Timeout timeout = Timeout::Infinite);
+    //! Gets the header of the current frame
+    Pipe::SpanIterator Header() const { return Spans(0, headerLength); }
+    //! Gets the payload of the current frame
+    Pipe::SpanIterator Frame() const { return Spans(headerLength, length); }
+
+    //! Writes a frame with the specified header and payload, the length field of the header is filled in
+    //! Throws FormatError without writing anything if the payload length does not fit the length field
+    async(Write, PipeWriter output, Span header, Span payload, Timeout timeout = Timeout::Infinite);
+
+private:
+    uint8_t headerLength, lengthOffset, lengthSize;
+    bool bigEndian;
+};
+
+//! Frames encoded using Consistent Overhead Byte Stuffing, each terminated by a zero byte
+class CobsFramer : public Framer
+{
+public:
+    //! Iterates the spans of a decoded frame, the zeros removed by the encoding are provided as separate spans
+    class SpanIterator
+    {
+    public:
+        SpanIterator() = default;
+
+        ALWAYS_INLINE bool operator ==(const SpanIterator& other) const { return remaining == other.remaining; }
+        ALWAYS_INLINE bool operator !=(const SpanIterator& other) const { return remaining != other.remaining; }
+        ALWAYS_INLINE SpanIterator& operator ++() { remaining -= span.Length(); Load(); return *this; }
+        ALWAYS_INLINE Span operator *() const { return span; }
+
+        ALWAYS_INLINE SpanIterator begin() const { return *this; }
+        ALWAYS_INLINE SpanIterator end() const { return SpanIterator(); }
+
+        ALWAYS_INLINE operator bool() const { return !!remaining; }
+        ALWAYS_INLINE size_t Available() const { return remaining; }
+
+    private:
+        SpanIterator(Pipe::Iterator it, size_t remaining)
+            : it(it), remaining(remaining) { Load(); }
+
+        Pipe::Iterator it;          //!< Next byte of the encoded frame
+        Span span;
+        size_t remaining = 0;       //!< Decoded bytes left, including the current span
+        uint8_t run = 0;            //!< Data bytes left in the current block
+        bool zero = false;          //!< The current block is followed by a zero
+
+        void Load();
+
+        friend class CobsFramer;
+    };
+
+    //! Creates a framer reading from @p input, discarding frames occupying more than @p maxLength bytes in it
+    CobsFramer(PipeReader input, size_t maxLength = FRAMER_MAX_LENGTH)
+        : Framer(input, maxLength) {}
+
+    //! Advances past the current frame and waits for the next complete one, empty frames are skipped
+    //! @returns true when a frame is available, false if the input completes
+    //! Throws FormatError if a frame is malformed or too long, the following frame can be read after that
+    async(Next, Timeout timeout = Timeout::Infinite);
+    //! Gets the decoded payload of the current frame
+    SpanIterator Frame() const { return length ? SpanIterator(input.Enumerate(size - 1), length) : SpanIterator(); }
+
+    //! Writes a frame with the specified payload
+    static async(Write, PipeWriter output, Span payload, Timeout timeout = Timeout::Infinite);
+
+private:
+    //! Checks the structure of the current frame and calculates its decoded length
+    bool Validate();
+};
+
+//! Frames encoded according to RFC 1055 (SLIP), each terminated by an END byte
+class SlipFramer : public Framer
+{
+public:
+    static constexpr uint8_t End = 0xC0;
+    static constexpr uint8_t Esc = 0xDB;
+    static constexpr uint8_t EscEnd = 0xDC;
+    static constexpr uint8_t EscEsc = 0xDD;
+
+    //! Iterates the spans of a decoded frame, the escaped bytes are provided as separate spans
+    class SpanIterator
+    {
+    public:
+        SpanIterator() = default;
+
+        ALWAYS_INLINE bool operator ==(const SpanIterator& other) const { return remaining == other.remaining; }
+        ALWAYS_INLINE bool operator !=(const SpanIterator& other) const { return remaining != other.remaining; }
+        ALWAYS_INLINE SpanIterator& operator ++() { remaining -= span.Length(); Load(); return *this; }
+        ALWAYS_INLINE Span operator *() const { return span; }
+
+        ALWAYS_INLINE SpanIterator begin() const { return *this; }
+        ALWAYS_INLINE SpanIterator end() const { return SpanIterator(); }
+
+        ALWAYS_INLINE operator bool() const { return !!remaining; }
+        ALWAYS_INLINE size_t Available() const { return remaining; }
+
+    private:
+        SpanIterator(Pipe::Iterator it, size_t remaining)
+            : it(it), remaining(remaining) { Load(); }
+
+        Pipe::Iterator it;          //!< Next byte of the encoded frame
+        Span span;
+        size_t remaining = 0;       //!< Decoded bytes left, including the current span
+
+        void Load();
+
+        friend class SlipFramer;
+    };
+
+    //! Creates a framer reading from @p input, discarding frames occupying more than @p maxLength bytes in it
+    SlipFramer(PipeReader input, size_t maxLength = FRAMER_MAX_LENGTH)
+        : Framer(input, maxLength) {}
+
+    //! Advances past the current frame and waits for the next complete one, empty frames are skipped
+    //! @returns true when a frame is available, false if the input completes
+    //! Throws FormatError if a frame is malformed or too long, the following frame can be read after that
+    async(Next, Timeout timeout = Timeout::Infinite);
+    //! Gets the decoded payload of the current frame
+    SpanIterator Frame() const { return length ? SpanIterator(input.Enumerate(size - 1), length) : SpanIterator(); }
+
+    //! Writes a frame with the specified payload, preceded by an END byte flushing any line noise
+    static async(Write, PipeWriter output, Span payload, Timeout timeout = Timeout::Infinite);
+
+private:
+    //! Checks the escape sequences of the current frame and calculates its decoded length
+    bool Validate();
+};
+
+}
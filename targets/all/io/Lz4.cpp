@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Lz4.cpp
+ */
+
+#include <io/Lz4.h>
+
+#include <io/Errors.h>
+
+namespace io
+{
+
+namespace
+{
+
+constexpr uint32_t FrameMagic = 0x184D2204;
+constexpr uint32_t Uncompressed = 0x80000000;
+// sequences shorter than this are not worth encoding as matches
+constexpr size_t MinMatch = 4;
+// the format requires the last five bytes to be literals and the last match to start twelve bytes before the end
+constexpr size_t LastLiterals = 5;
+constexpr size_t MatchLimit = 12;
+
+ALWAYS_INLINE uint32_t Read32(const uint8_t* p) { uint32_t v; memcpy(&v, p, 4); return v; }
+ALWAYS_INLINE void Write32LE(uint8_t* p, uint32_t v) { v = TO_LE32(v); memcpy(p, &v, 4); }
+ALWAYS_INLINE uint32_t Hash(uint32_t seq) { return (seq * 2654435761u) >> (32 - LZ4_HASH_BITS); }
+ALWAYS_INLINE constexpr uint32_t Rotl(uint32_t v, int n) { return (v << n) | (v >> (32 - n)); }
+
+//! xxHash32 of the frame descriptor, which is always shorter than the 16 bytes the hash processes in stripes
+uint32_t HeaderChecksum(const uint8_t* p, size_t length)
+{
+    constexpr uint32_t P1 = 2654435761u, P2 = 2246822519u, P3 = 3266489917u, P4 = 668265263u, P5 = 374761393u;
+    ASSERT(length < 16);
+    uint32_t h = P5 + length;
+    for (; length >= 4; p += 4, length -= 4)
+    {
+        h = Rotl(h + FROM_LE32(Read32(p)) * P3, 17) * P4;
+    }
+    for (; length; p++, length--)
+    {
+        h = Rotl(h + *p * P5, 11) * P1;
+    }
+    h ^= h >> 15; h *= P2;
+    h ^= h >> 13; h *= P3;
+    h ^= h >> 16;
+    return h;
+}
+
+//! Encodes the extension of a literal or match length that did not fit in the token
+ALWAYS_INLINE uint8_t* WriteLength(uint8_t* op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        *op++ = 255;
+    }
+    *op++ = length;
+    return op;
+}
+
+}
+
+Lz4Encoder::Lz4Encoder(size_t blockSize)
+    : blockSize(std::min(blockSize, MaxBlockSize))
+{
+    in = (uint8_t*)malloc(this->blockSize);
+    out = (uint8_t*)malloc(this->blockSize + 4);
+    table = (uint16_t*)malloc(sizeof(uint16_t) << LZ4_HASH_BITS);
+    ASSERT(in && out && table);
+}
+
+Lz4Encoder::~Lz4Encoder()
+{
+    free(in);
+    free(out);
+    free(table);
+}
+
+size_t Lz4Encoder::CompressBlock(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity)
+{
+    ASSERT(length <= MaxBlockSize);
+
+    // stale entries from previous blocks are rejected when the bytes they point to are compared
+    memset(table, 0, sizeof(uint16_t) << LZ4_HASH_BITS);
+
+    uint8_t* op = dst;
+    uint8_t* oend = dst + capacity;
+    size_t ip = 0, anchor = 0;
+    size_t limit = length > MatchLimit ? length - MatchLimit : 0;
+
+    while (ip < limit)
+    {
+        uint32_t seq = Read32(src + ip);
+        uint32_t h = Hash(seq);
+        size_t ref = table[h];
+        table[h] = ip;
+
+        if (ref >= ip || Read32(src + ref) != seq)
+        {
+            // skip faster through data that does not compress
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+
+        size_t match = MinMatch;
+        while (ip + match < length - LastLiterals && src[ref + match] == src[ip + match])
+        {
+            match++;
+        }
+
+        size_t literals = ip - anchor;
+        // token, length extensions, literals and offset
+        if (size_t(oend - op) < 1 + literals / 255 + 1 + literals + 2 + (match - MinMatch) / 255 + 1)
+        {
+            return 0;
+        }
+
+        uint8_t* token = op++;
+        *token = (std::min(literals, size_t(15)) << 4) | std::min(match - MinMatch, size_t(15));
+        if (literals >= 15)
+        {
+            op = WriteLength(op, literals - 15);
+        }
+        memcpy(op, src + anchor, literals);
+        op += literals;
+        *op++ = uint8_t(ip - ref);
+        *op++ = uint8_t((ip - ref) >> 8);
+        if (match - MinMatch >= 15)
+        {
+            op = WriteLength(op, match - MinMatch - 15);
+        }
+
+        ip += match;
+        anchor = ip;
+        if (ip < limit)
+        {
+            // the position just before the next one often starts a repetition as well
+            table[Hash(Read32(src + ip - 2))] = ip - 2;
+        }
+    }
+
+    size_t literals = length - anchor;
+    if (size_t(oend - op) < 1 + literals / 255 + 1 + literals)
+    {
+        return 0;
+    }
+
+    *op++ = std::min(literals, size_t(15)) << 4;
+    if (literals >= 15)
+    {
+        op = WriteLength(op, literals - 15);
+    }
+    memcpy(op, src + anchor, literals);
+    op += literals;
+    return op - dst;
+}
+
+async(Lz4Encoder::Run, PipeReader input, PipeWriter output)
+async_def(
+    size_t length, n;
+)
+{
+    // version 1 with independent blocks of up to 64 kB, no checksums
+    Write32LE(out, FrameMagic);
+    out[4] = 0x60;
+    out[5] = 0x40;
+    out[6] = HeaderChecksum(out + 4, 2) >> 8;
+    await(output.Write, Span(out, 7));
+
+    do
+    {
+        f.n = await(input.Read, Buffer(in + f.length, blockSize - f.length));
+        f.length += f.n;
+
+        // a block is emitted when full or when the input has nothing more for it right now
+        if (f.length && (f.length == blockSize || !input.Available()))
+        {
+            // blocks that do not compress are stored as they are
+            if (size_t compressed = CompressBlock(in, f.length, out + 4, f.length - 1))
+            {
+                Write32LE(out, compressed);
+                f.length = compressed;
+            }
+            else
+            {
+                Write32LE(out, f.length | Uncompressed);
+                memcpy(out + 4, in, f.length);
+            }
+
+            await(output.Write, Span(out, f.length + 4));
+            f.length = 0;
+        }
+    } while (f.n);
+
+    // end mark
+    Write32LE(out, 0);
+    await(output.Write, Span(out, 4));
+    output.Close();
+}
+async_end
+
+Lz4Decoder::Lz4Decoder(size_t blockSize)
+    : blockSize(std::max(blockSize, size_t(16)))
+{
+    in = (uint8_t*)malloc(this->blockSize);
+    out = (uint8_t*)malloc(this->blockSize);
+    ASSERT(in && out);
+}
+
+Lz4Decoder::~Lz4Decoder()
+{
+    free(in);
+    free(out);
+}
+
+ptrdiff_t Lz4Decoder::DecompressBlock(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + length;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + capacity;
+
+    while (ip < iend)
+    {
+        uint8_t token = *ip++;
+
+        size_t literals = token >> 4;
+        if (literals == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip == iend)
+                    return -1;
+                literals += b = *ip++;
+            } while (b == 255);
+        }
+
+        if (size_t(iend - ip) < literals || size_t(oend - op) < literals)
+        {
+            return -1;
+        }
+        memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+
+        if (ip == iend)
+        {
+            // the last sequence has no match
+            break;
+        }
+
+        if (iend - ip < 2)
+        {
+            return -1;
+        }
+        size_t offset = ip[0] | ip[1] << 8;
+        ip += 2;
+        if (!offset || offset > size_t(op - dst))
+        {
+            return -1;
+        }
+
+        size_t match = token & 15;
+        if (match == 15)
+        {
+            uint8_t b;
+            do
+            {
+                if (ip == iend)
+                    return -1;
+                match += b = *ip++;
+            } while (b == 255);
+        }
+        match += MinMatch;
+
+        if (size_t(oend - op) < match)
+        {
+            return -1;
+        }
+
+        const uint8_t* ref = op - offset;
+        if (offset >= match)
+        {
+            memcpy(op, ref, match);
+            op += match;
+        }
+        else
+        {
+            // overlapping matches repeat the last offset bytes
+            for (size_t i = 0; i < match; i++)
+            {
+                *op++ = *ref++;
+            }
+        }
+    }
+
+    return op - dst;
+}
+
+async(Lz4Decoder::ReadFully, PipeReader input, uint8_t* buffer, size_t length)
+async_def(
+    size_t read, n;
+)
+{
+    while (f.read < length && (f.n = await(input.Read, Buffer(buffer + f.read, length - f.read))))
+    {
+        f.read += f.n;
+    }
+    async_return(f.read == length);
+}
+async_end
+
+async(Lz4Decoder::Run, PipeReader input, PipeWriter output)
+async_def(
+    uint8_t flg;
+    size_t header;
+    uint32_t size;
+    ptrdiff_t n;
+    uint8_t skip[4];
+)
+{
+    // frames may follow each other until the input completes
+    while (await(input.Require, 1))
+    {
+        if (!await(ReadFully, input, in, 6) || FROM_LE32(Read32(in)) != FrameMagic)
+        {
+            async_throw(FormatError, 0);
+        }
+
+        f.flg = in[4];
+        // version 1 with independent blocks only, no dictionary, no reserved bits set
+        if ((f.flg & 0xE3) != 0x60 || (in[5] & 0x8F))
+        {
+            async_throw(FormatError, 0);
+        }
+
+        // optional content size followed by the header checksum
+        f.header = 2 + (f.flg & 0x08 ? 8 : 0);
+        if (!await(ReadFully, input, in + 6, f.header - 1) || in[4 + f.header] != uint8_t(HeaderChecksum(in + 4, f.header) >> 8))
+        {
+            async_throw(FormatError, 0);
+        }
+
+        for (;;)
+        {
+            if (!await(ReadFully, input, (uint8_t*)&f.size, 4))
+            {
+                async_throw(FormatError, 0);
+            }
+            f.size = FROM_LE32(f.size);
+            if (!f.size)
+            {
+                break;
+            }
+
+            if ((f.size & ~Uncompressed) > blockSize || !await(ReadFully, input, in, f.size & ~Uncompressed))
+            {
+                async_throw(FormatError, 0);
+            }
+
+            if (f.flg & 0x10 && !await(ReadFully, input, f.skip, 4))
+            {
+                async_throw(FormatError, 0);
+            }
+
+            if (f.size & Uncompressed)
+            {
+                await(output.Write, Span(in, f.size & ~Uncompressed));
+            }
+            else
+            {
+                f.n = DecompressBlock(in, f.size, out, blockSize);
+                if (f.n < 0)
+                {
+                    async_throw(FormatError, 0);
+                }
+                await(output.Write, Span(out, f.n));
+            }
+        }
+
+        if (f.flg & 0x04 && !await(ReadFully, input, f.skip, 4))
+        {
+            async_throw(FormatError, 0);
+        }
+    }
+
+    output.Close();
+}
+async_end
+
+}
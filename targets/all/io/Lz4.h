@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Lz4.h
+ *
+ * Pipe stages producing and consuming LZ4 frames, interoperable with the
+ * reference lz4 implementation. Input is compressed in independent blocks of
+ * a configurable size, a block being emitted whenever it fills up or the
+ * input pipe runs dry, so the latency is bounded by that of the input.
+ *
+ * The decoder accepts frames with independent blocks that fit in its block
+ * buffer, i.e. files compressed by the lz4 tool with -B4 (64 kB blocks) by
+ * default. Block and content checksums are skipped, not verified.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+//! Number of bits of the hash used to find matches, the encoder allocates two bytes per entry
+#ifndef LZ4_HASH_BITS
+#define LZ4_HASH_BITS   12
+#endif
+
+namespace io
+{
+
+class Lz4Encoder
+{
+public:
+    //! Largest block the frame header can declare without requiring larger buffers from the decoders
+    static constexpr size_t MaxBlockSize = 65536;
+
+    //! Creates an encoder compressing blocks of up to @p blockSize bytes
+    Lz4Encoder(size_t blockSize = 4096);
+    ~Lz4Encoder();
+
+    //! Compresses all data from @p input into a single frame written to @p output, closing the output once the input completes
+    async(Run, PipeReader input, PipeWriter output);
+
+    //! Compresses a single block into a buffer of @p capacity bytes
+    //! @returns the length of the compressed data, zero if it does not fit
+    size_t CompressBlock(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity);
+
+private:
+    size_t blockSize;
+    uint8_t* in;            //!< Input accumulated for the next block
+    uint8_t* out;           //!< Block header and compressed data
+    uint16_t* table;        //!< Last positions of hashed sequences in the current block
+};
+
+class Lz4Decoder
+{
+public:
+    //! Creates a decoder accepting blocks of up to @p blockSize bytes
+    Lz4Decoder(size_t blockSize = Lz4Encoder::MaxBlockSize);
+    ~Lz4Decoder();
+
+    //! Decompresses all frames from @p input to @p output, closing the output once the input completes
+    //! Throws FormatError if the input is not a supported LZ4 frame
+    async(Run, PipeReader input, PipeWriter output);
+
+    //! Decompresses a single block into a buffer of @p capacity bytes
+    //! @returns the length of the decompressed data, -1 if the block is malformed or does not fit
+    static ptrdiff_t DecompressBlock(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity);
+
+private:
+    size_t blockSize;
+    uint8_t* in;            //!< Compressed block, or frame header
+    uint8_t* out;           //!< Decompressed block
+
+    //! Reads exactly @p length bytes, returns false if the input completes first
+    static async(ReadFully, PipeReader input, uint8_t* buffer, size_t length);
+};
+
+}
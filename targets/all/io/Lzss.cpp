@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Lzss.cpp
+ */
+
+#include <io/Lzss.h>
+
+#include <io/Errors.h>
+
+namespace io
+{
+
+namespace
+{
+
+constexpr size_t MinMatch = 3;
+constexpr size_t MaxMatch = MinMatch + 15;
+// flags of a new group, a match and the match ending the group when flushing
+constexpr size_t MaxItem = 1 + 2 + 2;
+
+ALWAYS_INLINE uint32_t Hash(const uint8_t* p) { return ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >> (32 - LZSS_HASH_BITS); }
+
+}
+
+static_assert(LZSS_BUFFER >= MaxMatch + MaxItem, "LZSS_BUFFER too small");
+
+LzssEncoder::LzssEncoder(unsigned windowBits)
+    : windowBits(std::min(std::max(windowBits, 8u), 12u))
+{
+    buf = (uint8_t*)malloc(Window() * 2);
+    table = (uint16_t*)malloc(sizeof(uint16_t) << LZSS_HASH_BITS);
+    ASSERT(buf && table);
+}
+
+LzssEncoder::~LzssEncoder()
+{
+    free(buf);
+    free(table);
+}
+
+void LzssEncoder::Slide()
+{
+    size_t window = Window();
+    if (end < window * 2 || pos < window)
+    {
+        return;
+    }
+
+    memmove(buf, buf + window, window);
+    pos -= window;
+    end -= window;
+    for (size_t i = 0; i < (size_t(1) << LZSS_HASH_BITS); i++)
+    {
+        table[i] = table[i] > window ? table[i] - window : 0;
+    }
+}
+
+void LzssEncoder::Encode(bool flush)
+{
+    // the distance is limited to twelve bits, zero marking the end of a group
+    size_t maxDistance = Window() - 1;
+
+    while (end - pos >= (flush ? 1 : MaxMatch) && length + MaxItem <= sizeof(out))
+    {
+        if (!items)
+        {
+            group = length;
+            out[length++] = 0;
+        }
+
+        size_t match = 0, distance = 0;
+        if (end - pos >= MinMatch)
+        {
+            uint32_t h = Hash(buf + pos);
+            size_t ref = table[h];
+            table[h] = pos + 1;
+            if (ref-- && pos - ref <= maxDistance)
+            {
+                size_t max = std::min(end - pos, MaxMatch);
+                while (match < max && buf[ref + match] == buf[pos + match])
+                {
+                    match++;
+                }
+                distance = pos - ref;
+            }
+        }
+
+        if (match >= MinMatch)
+        {
+            out[group] |= 1 << items;
+            uint16_t v = distance << 4 | (match - MinMatch);
+            out[length++] = v >> 8;
+            out[length++] = v;
+            // index the positions inside the match as well, repetitions often start there
+            for (size_t i = 1; i < match && pos + i + MinMatch <= end; i++)
+            {
+                table[Hash(buf + pos + i)] = pos + i + 1;
+            }
+            pos += match;
+        }
+        else
+        {
+            out[length++] = buf[pos++];
+        }
+
+        if (++items == 8)
+        {
+            items = 0;
+        }
+    }
+}
+
+async(LzssEncoder::Run, PipeReader input, PipeWriter output)
+async_def(
+    size_t n, ready;
+    bool flush;
+)
+{
+    items = 0;
+    pos = end = 0;
+    memset(table, 0, sizeof(uint16_t) << LZSS_HASH_BITS);
+    out[0] = windowBits;
+    length = 1;
+
+    do
+    {
+        Slide();
+        f.n = await(input.Read, Buffer(buf + end, Window() * 2 - end));
+        end += f.n;
+        // everything is encoded when the input has nothing more right now
+        f.flush = !input.Available();
+
+        do
+        {
+            Encode(f.flush);
+            if (f.flush && pos == end && items)
+            {
+                if (f.n)
+                {
+                    // a match with zero distance ends the group, so that the decoder can output everything
+                    out[group] |= 1 << items;
+                    out[length++] = 0;
+                    out[length++] = 0;
+                }
+                // at the end of the input the group simply ends with the stream
+                items = 0;
+            }
+
+            // only complete groups can be written, the flags of the open one may still change
+            f.ready = items ? group : length;
+            if (f.ready)
+            {
+                await(output.Write, Span(out, f.ready));
+                memmove(out, out + f.ready, length - f.ready);
+                length -= f.ready;
+                group -= items ? f.ready : 0;
+            }
+        } while (end - pos >= (f.flush ? 1 : MaxMatch));
+    } while (f.n);
+
+    output.Close();
+}
+async_end
+
+LzssDecoder::LzssDecoder(unsigned windowBits)
+    : windowBits(std::min(std::max(windowBits, 8u), 12u))
+{
+    window = (uint8_t*)malloc(size_t(1) << this->windowBits);
+    ASSERT(window);
+}
+
+LzssDecoder::~LzssDecoder()
+{
+    free(window);
+}
+
+size_t LzssDecoder::Decode(Span input)
+{
+    auto p = (const uint8_t*)input.Pointer();
+    auto e = p + input.Length();
+    size_t mask = (size_t(1) << windowBits) - 1;
+
+    while (p < e && length + MaxMatch <= sizeof(out))
+    {
+        uint8_t b = *p++;
+        if (!items)
+        {
+            flags = b;
+            items = 8;
+            continue;
+        }
+
+        if (!(flags & 1))
+        {
+            window[total++ & mask] = out[length++] = b;
+        }
+        else if (!split)
+        {
+            high = b;
+            split = true;
+            continue;
+        }
+        else
+        {
+            split = false;
+            size_t distance = (high << 4) | (b >> 4);
+            if (!distance)
+            {
+                items = 0;
+                continue;
+            }
+
+            if (distance > std::min(total, mask))
+            {
+                error = true;
+                break;
+            }
+
+            for (size_t n = (b & 15) + MinMatch; n; n--)
+            {
+                window[total & mask] = out[length++] = window[(total - distance) & mask];
+                total++;
+            }
+        }
+
+        flags >>= 1;
+        items--;
+    }
+
+    return p - (const uint8_t*)input.Pointer();
+}
+
+async(LzssDecoder::Run, PipeReader input, PipeWriter output)
+async_def(
+    uint8_t bits;
+)
+{
+    items = 0;
+    split = error = false;
+    total = length = 0;
+
+    if (await(input.Read, Buffer(&f.bits, 1)))
+    {
+        if (f.bits < 8 || f.bits > windowBits)
+        {
+            async_throw(FormatError, 0);
+        }
+
+        while (await(input.Require, 1))
+        {
+            input.Advance(Decode(input.GetSpan()));
+            if (error)
+            {
+                async_throw(FormatError, 0);
+            }
+
+            if (length)
+            {
+                await(output.Write, Span(out, length));
+                length = 0;
+            }
+        }
+
+        if (split)
+        {
+            // truncated in the middle of a match
+            async_throw(FormatError, 0);
+        }
+    }
+
+    output.Close();
+}
+async_end
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/Lzss.h
+ *
+ * Small-window LZ77 codec with a RAM footprint bounded by the window size,
+ * for links where the LZ4 block buffers do not fit.
+ *
+ * The stream starts with a byte holding the number of window bits (8-12),
+ * followed by groups of up to eight items, each group preceded by a byte
+ * with a bit for every item (least significant first). A clear bit marks
+ * a literal byte, a set bit a two byte big-endian match with the distance
+ * in the upper twelve bits and the length minus three in the lower four.
+ * A zero distance ends the group early, which is how the encoder flushes
+ * everything it has when the input pipe runs dry.
+ *
+ * The encoder uses two windows of input and a hash table of LZSS_HASH_BITS,
+ * the decoder a single window, plus an output buffer of LZSS_BUFFER bytes each.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+//! Number of bits of the hash used to find matches, the encoder allocates two bytes per entry
+#ifndef LZSS_HASH_BITS
+#define LZSS_HASH_BITS  10
+#endif
+
+//! Size of the buffers in which the codecs collect their output before writing it to the pipe
+#ifndef LZSS_BUFFER
+#define LZSS_BUFFER     128
+#endif
+
+namespace io
+{
+
+class LzssEncoder
+{
+public:
+    //! Creates an encoder looking for matches up to 2^@p windowBits - 1 bytes back
+    LzssEncoder(unsigned windowBits = 10);
+    ~LzssEncoder();
+
+    //! Compresses all data from @p input to @p output, closing the output once the input completes
+    async(Run, PipeReader input, PipeWriter output);
+
+private:
+    uint8_t windowBits;
+    uint8_t items = 0;          //!< Number of items in the group being encoded, zero when none is open
+    uint16_t group;             //!< Offset of the flags of the open group in the output buffer
+    size_t pos = 0, end = 0;    //!< Position of the next byte to encode and end of the input in the buffer
+    size_t length = 0;          //!< Bytes in the output buffer
+    uint8_t* buf;               //!< History window followed by the input to encode
+    uint16_t* table;            //!< Last positions (+1) of hashed sequences in the buffer
+    uint8_t out[LZSS_BUFFER];
+
+    size_t Window() const { return size_t(1) << windowBits; }
+    //! Encodes buffered input while there is room in the output buffer, all of it when @p flush is set
+    void Encode(bool flush);
+    //! Discards the oldest window of history to make room for more input
+    void Slide();
+};
+
+class LzssDecoder
+{
+public:
+    //! Creates a decoder accepting streams with windows of up to 2^@p windowBits bytes
+    LzssDecoder(unsigned windowBits = 12);
+    ~LzssDecoder();
+
+    //! Decompresses all data from @p input to @p output, closing the output once the input completes
+    //! Throws FormatError if the input is malformed or uses a larger window
+    async(Run, PipeReader input, PipeWriter output);
+
+private:
+    uint8_t windowBits;
+    uint8_t flags;              //!< Remaining bits of the group flags
+    uint8_t items = 0;          //!< Remaining items in the current group
+    uint8_t high;               //!< First byte of a match split between spans
+    bool split = false;
+    bool error = false;
+    size_t total = 0;           //!< Number of bytes decoded, the window position is derived from it
+    size_t length = 0;          //!< Bytes in the output buffer
+    uint8_t* window;
+    uint8_t out[LZSS_BUFFER];
+
+    //! Decodes as much of the span as fits in the output buffer, returns the number of bytes consumed
+    size_t Decode(Span input);
+};
+
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/MulticastPipe.cpp
+ */
+
+#include <io/MulticastPipe.h>
+
+#if PIPE_TRACE
+#define MYTRACE(fmt, ...)        DBGCL("multicast", "[%p] " fmt, this, ## __VA_ARGS__)
+#else
+#define MYTRACE(...)
+#endif
+
+namespace io
+{
+
+size_t MulticastPipe::Readers() const
+{
+    size_t n = 0;
+    for (auto r = readers; r; r = r->next)
+    {
+        n++;
+    }
+    return n;
+}
+
+void MulticastPipe::Update()
+{
+    auto wpos = PipeWriter(pipe).Position();
+    auto min = wpos;
+    size_t limit = 0, drop = 0;
+
+    for (auto pp = &readers; auto r = *pp;)
+    {
+        size_t lag = wpos - r->pos;
+        if (r->lag && r->policy == MulticastLag::Drop && lag > r->lag)
+        {
+            MYTRACE("dropping reader %p lagging %u bytes behind", r, lag);
+            r->dropped = true;
+            *pp = r->next;
+            continue;
+        }
+
+        if (r->pos < min)
+        {
+            min = r->pos;
+        }
+
+        if (r->lag)
+        {
+            if (r->policy == MulticastLag::Throttle)
+            {
+                limit = limit ? std::min(limit, r->lag) : r->lag;
+            }
+            else
+            {
+                drop = std::max(drop, r->lag);
+            }
+        }
+        pp = &r->next;
+    }
+
+    // writes are held only when the writer needs a new segment, i.e. the data in the pipe
+    // is all written, so a throttle level above the drop limits lets dropping readers exceed them
+    size_t level = throttle && throttle <= drop ? drop + 1 : throttle;
+    if (level && (!limit || level < limit))
+    {
+        limit = level;
+    }
+
+    if (pipe.ThrottleLevel() != limit)
+    {
+        pipe.ThrottleLevel(limit);
+    }
+
+    PipeReader(pipe).AdvanceTo(min);
+}
+
+MulticastReader::MulticastReader(MulticastPipe& owner, size_t lag, MulticastLag policy)
+    : owner(owner), next(owner.readers), pos(PipeWriter(owner.pipe).Position()), lag(lag), policy(policy)
+{
+    owner.readers = this;
+    owner.Update();
+}
+
+void MulticastReader::Detach()
+{
+    if (dropped)
+    {
+        return;
+    }
+
+    auto pp = &owner.readers;
+    while (*pp != this)
+    {
+        pp = &(*pp)->next;
+    }
+    *pp = next;
+    dropped = true;
+    owner.Update();
+}
+
+Span MulticastReader::Read(Buffer buffer)
+{
+    Span res = Shared().Peek(Buffer(buffer.Pointer(), std::min(buffer.Length(), Available())), Offset());
+    Advance(res.Length());
+    return res;
+}
+
+void MulticastReader::Advance(size_t count)
+{
+    if (dropped)
+    {
+        return;
+    }
+
+    ASSERT(count <= Available());
+    pos += count;
+    owner.Update();
+}
+
+async(MulticastReader::Require, size_t count, Timeout timeout)
+async_def(
+    Timeout timeout;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    while (!dropped && Available() < count && !owner.pipe.IsClosed())
+    {
+        // readers waiting for data are the ones keeping up, let them drop the laggards
+        owner.Update();
+        if (dropped)
+        {
+            break;
+        }
+
+        if (!await(owner.pipe.Change, f.timeout))
+        {
+            async_throw(TimeoutError, Available());
+        }
+    }
+
+    async_return(Available());
+}
+async_end
+
+}
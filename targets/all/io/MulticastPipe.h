@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/MulticastPipe.h
+ *
+ * Pipe with a single writer and any number of independent readers. All
+ * readers see the same segments, each reading at its own position, and the
+ * segments are released once the slowest reader advances past them.
+ *
+ * Readers registered with a lag limit either hold the writer when they fall
+ * behind by the limit, or are dropped when they fall behind by more than it.
+ * Dropping is evaluated as readers advance or wait for data, so at least one
+ * other reader must keep reading for a lagging one to be dropped.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+namespace io
+{
+
+class MulticastReader;
+
+//! What happens when a multicast reader lags behind the writer by its limit
+enum struct MulticastLag : uint8_t
+{
+    Throttle,       //!< Writes are held until the reader catches up
+    Drop,           //!< The reader is detached and sees the end of the stream
+};
+
+class MulticastPipe
+{
+public:
+    MulticastPipe(PipeAllocator& allocator = *PipeAllocator::s_default)
+        : pipe(allocator)
+    {
+    }
+
+    ~MulticastPipe() { ASSERT(!readers); }
+
+    //! Gets the writer of the pipe, writes are held while no reader is registered
+    PipeWriter Writer() { return pipe; }
+    //! Closes the pipe, readers complete after reading the remaining data
+    void Close() { PipeWriter(pipe).Close(); }
+    bool IsClosed() const { return pipe.IsClosed(); }
+
+    //! Gets the number of registered readers, excluding dropped ones
+    size_t Readers() const;
+    //! Gets the number of bytes retained for the slowest reader
+    size_t Retained() const { return pipe.Unprocessed(); }
+
+    size_t ThrottleLevel() const { return throttle; }
+    //! Sets the level at which writes are held regardless of reader lag limits
+    void ThrottleLevel(size_t bytes) { throttle = bytes; Update(); }
+
+private:
+    Pipe pipe;
+    MulticastReader* readers = NULL;
+    size_t throttle = 1024;
+
+    //! Drops readers lagging beyond their limits and releases data all remaining readers are done with
+    void Update();
+
+    friend class MulticastReader;
+};
+
+class MulticastReader
+{
+public:
+    //! Registers a reader starting at the current position of the writer,
+    //! a zero @p lag means the reader is limited only by the throttle level of the pipe
+    MulticastReader(MulticastPipe& owner, size_t lag = 0, MulticastLag policy = MulticastLag::Throttle);
+    ~MulticastReader() { Detach(); }
+
+    MulticastReader(const MulticastReader&) = delete;
+    MulticastReader& operator =(const MulticastReader&) = delete;
+
+    //! Waits for at least @p count bytes, returns fewer only if the pipe closes or the reader is dropped
+    async(Require, size_t count = 1, Timeout timeout = Timeout::Infinite);
+    //! Waits for the next change in pipe state, returns false on timeout
+    async_once(Change, Timeout timeout = Timeout::Infinite) { return async_forward(owner.pipe.Change, timeout); }
+
+    Span GetSpan(size_t offset = 0) const { return Available() > offset ? Shared().GetSpan(Offset() + offset) : Span(); }
+    int Peek(size_t offset) const { return Available() > offset ? Shared().Peek(Offset() + offset) : -1; }
+    bool Matches(Span data, size_t offset = 0) const { return Available() >= offset + data.Length() && Shared().Matches(data, Offset() + offset); }
+    //! Copies up to the length of the buffer into it and advances past the copied data
+    Span Read(Buffer buffer);
+    void Advance(size_t count);
+
+    PipePosition Position() const { return pos; }
+    size_t Available() const { return dropped ? 0 : PipeWriter(owner.pipe).Position() - pos; }
+    bool IsComplete() const { return dropped || (owner.pipe.IsClosed() && !Available()); }
+    //! Returns true if the reader was detached for lagging behind by more than its limit
+    bool IsDropped() const { return dropped; }
+
+    size_t LagLimit() const { return lag; }
+    MulticastLag LagPolicy() const { return policy; }
+
+    Pipe::Iterator begin() const { return Available() ? Shared().begin() + Offset() : Pipe::Iterator(); }
+    Pipe::Iterator end() const { return Pipe::Iterator(); }
+
+private:
+    MulticastPipe& owner;
+    MulticastReader* next;
+    PipePosition pos;
+    size_t lag;
+    MulticastLag policy;
+    bool dropped = false;
+
+    PipeReader Shared() const { return PipeReader(owner.pipe); }
+    //! Offset of the reader position from the oldest retained data
+    size_t Offset() const { return Shared().LengthUntil(pos); }
+    void Detach();
+
+    friend class MulticastPipe;
+};
+
+}
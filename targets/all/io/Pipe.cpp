@@ -13,6 +13,7 @@
 
 #include <base/format.h>
 #include <base/MemPoolAsync.h>
+#include <base/memsearch.h>
 
 //#define PIPE_TRACE  1
 
@@ -24,6 +25,24 @@
 #define MYTRACE(...)
 #endif
 
+#if PIPE_STATS
+#define PIPE_STATS_WRITE(n)             ({ written += (n); })
+#define PIPE_STATS_READ(n)              ({ read += (n); })
+#define PIPE_STATS_SEGMENT()            ({ segments++; })
+#define PIPE_STATS_PEAK()               ({ if (TotalBytes() > peak) { peak = TotalBytes(); } })
+#define PIPE_STATS_WAIT_BEGIN(start)    ({ start = MONO_CLOCKS; })
+#define PIPE_STATS_WAIT_END(start, total)   ({ total += MONO_CLOCKS - start; })
+#define PIPE_STATS_WASTED(n)            ({ PipeAllocator::s_stats.wasted += (n); })
+#else
+#define PIPE_STATS_WRITE(n)
+#define PIPE_STATS_READ(n)
+#define PIPE_STATS_SEGMENT()
+#define PIPE_STATS_PEAK()
+#define PIPE_STATS_WAIT_BEGIN(start)
+#define PIPE_STATS_WAIT_END(start, total)
+#define PIPE_STATS_WASTED(n)
+#endif
+
 namespace io
 {
 
@@ -44,6 +63,31 @@ struct PipeReferencedSegment : PipeSegment
     PipeSegment* inner;
 };
 
+// external segments are limited by the 16-bit segment length, keep the chunks word-aligned
+static constexpr size_t ExternalChunkMax = 0xFFFC;
+
+struct PipeExternalSegment : PipeSegment
+{
+    PipeExternalSegment(Span data, Delegate<void, Span> release)
+        : PipeSegment((const uint8_t*)data.Pointer(), std::min(data.Length(), ExternalChunkMax)), whole(data), release(release)
+    {
+    }
+
+    virtual void Destroy()
+    {
+        auto whole = this->whole;
+        auto release = this->release;
+        MemPoolFree<PipeExternalSegment>(this);
+        if (release)
+        {
+            release(whole);
+        }
+    }
+
+    Span whole;
+    Delegate<void, Span> release;
+};
+
 void Pipe::Cleanup()
 {
     MYTRACE("Cleanup");
@@ -59,12 +103,14 @@ void Pipe::Cleanup()
     rseg = NULL;
     pwseg = NULL;
     roff = woff = 0;
+    PIPE_STATS_WASTED(apos - wpos);
     rpos = apos = wpos;
 }
 
 void Pipe::Reset()
 {
     MYTRACE("Reset");
+    WriterFlush();
     if (rseg)
     {
         Cleanup();
@@ -73,10 +119,64 @@ void Pipe::Reset()
     pwseg = &rseg;
     rpos = apos = wpos = 0;
     roff = woff = 0;
+    grow = 0;
     state++;
     WriterSignal();
 }
 
+#if PIPE_STATS
+Pipe* Pipe::s_first;
+
+void Pipe::Register(const char* name)
+{
+    if (!this->name)
+    {
+        next = s_first;
+        s_first = this;
+    }
+    this->name = name;
+}
+
+void Pipe::Unregister()
+{
+    if (!name)
+    {
+        return;
+    }
+
+    for (Pipe** pp = &s_first; *pp; pp = &(*pp)->next)
+    {
+        if (*pp == this)
+        {
+            *pp = next;
+            break;
+        }
+    }
+    name = NULL;
+    next = NULL;
+}
+
+int Pipe::DumpJson(format_output output, void* context)
+{
+    int res = 0;
+    for (auto pipe = First(); pipe; pipe = pipe->Next())
+    {
+        auto s = pipe->Stats();
+        res += format(output, context, "%c{\"name\":\"%s\",\"written\":%u,\"read\":%u,\"segments\":%u,\"peak\":%u,\"changes\":%u,"
+            "\"throttleCount\":%u,\"throttleTime\":%u,\"allocateTime\":%u,\"requireTime\":%u}",
+            res ? ',' : '[', s.name, s.written, s.read, s.segments, s.peak, s.changes,
+            s.throttleCount, unsigned(s.throttleTime), unsigned(s.allocateTime), unsigned(s.requireTime));
+    }
+    if (!res)
+    {
+        output(context, '[');
+        res++;
+    }
+    output(context, ']');
+    return res + 1;
+}
+#endif
+
 async(Pipe::Completed, Timeout timeout)
 async_def(
     Timeout timeout
@@ -143,6 +243,55 @@ async_def(
 }
 async_end
 
+async(Pipe::WriterWriteV, const Span* parts, size_t count, Timeout timeout)
+async_def(
+    Timeout timeout;
+    size_t length, written;
+    size_t part, offset;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    for (size_t i = 0; i < count; i++)
+    {
+        f.length += parts[i].Length();
+    }
+
+    while (f.written < f.length)
+    {
+        if (wpos == apos)
+        {
+            await(WriterAllocate, f.length - f.written, f.timeout);
+        }
+
+        ASSERT(pwseg && *pwseg);
+        ASSERT((*pwseg)->length > woff);
+        auto dst = (uint8_t*)(*pwseg)->data + woff;
+        size_t avail = std::min(f.length - f.written, (*pwseg)->length - woff);
+        size_t block = 0;
+
+        // fill the current segment from as many parts as fit
+        while (block < avail)
+        {
+            Span part = parts[f.part];
+            size_t n = std::min(part.Length() - f.offset, avail - block);
+            memcpy(dst + block, part.Pointer() + f.offset, n);
+            block += n;
+            if ((f.offset += n) == part.Length())
+            {
+                f.part++;
+                f.offset = 0;
+            }
+        }
+
+        f.written += block;
+        WriterAdvance(block);
+    }
+
+    async_return(f.written);
+}
+async_end
+
 async(Pipe::WriterWriteFV, Timeout timeout, const char* format, va_list va)
 async_def(
     Timeout timeout;
@@ -167,24 +316,119 @@ async_def(
 {
     f.timeout = timeout.MakeAbsolute();
 
-    do
+    // the first pass fills the space already allocated and measures the output, space for all the rest
+    // is then reserved up front across as many segments as needed, so the output is normally complete
+    // after the second pass; more passes are needed only if the throttle level prevents the reservation
+    for (;;)
     {
-        if (wpos == apos)
-        {
-            await(WriterAllocate, f.length - f.written, f.timeout);
-        }
-
         auto before = f.written;
         f.length = 0;
-        f.seg = *pwseg;
+        f.seg = WriterAvailable() ? *pwseg : NULL;
         f.offset = woff;
         va_list va2;
         va_copy(va2, va);
         vformat(&f.format_output, &f, format, va2);
         va_end(va2);
-        WriterAdvance(f.written - before);
-    } while (f.written < f.length);
+        if (f.written > before)
+        {
+            WriterAdvance(f.written - before);
+        }
+
+        if (f.written == f.length)
+        {
+            break;
+        }
+
+        await(WriterAllocate, f.length - f.written, f.timeout);
+        while (WriterAvailable() < f.length - f.written && WriterCanAllocate())
+        {
+            await(WriterAllocate, f.length - f.written - WriterAvailable(), f.timeout);
+        }
+    }
+
+    async_return(f.written);
+}
+async_end
+
+async(Pipe::WriterWriteExternal, const char* data, size_t length, Delegate<void, Span> release, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipeSegment* owner;
+    size_t written;
+
+    void ReleaseOwner()
+    {
+        // the implicit reference is transferred to the pipe with the first chunk, drop it if nothing was linked
+        if (!written)
+        {
+            owner->Release();
+        }
+        owner->Release();
+    }
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    void* mem;
+    while (!(mem = MemPoolAlloc<PipeExternalSegment>()))
+    {
+        if (!await_mempool_timeout(PipeExternalSegment, f.timeout))
+        {
+            if (release)
+            {
+                release(Span(data, length));
+            }
+            async_throw(TimeoutError, 0);
+        }
+    }
+
+    // the first chunk is the segment owning the data, the rest reference it
+    f.owner = new(mem) PipeExternalSegment(Span(data, length), release);
+    f.owner->Reference();
+
+    while (f.written < length)
+    {
+        while (WriterThrottled() && !IsClosed())
+        {
+            MYTRACE("W: throttling external data at %d bytes", TotalBytes());
+            if (!await_mask_not_timeout(state, ~0u, state, f.timeout))
+            {
+                f.ReleaseOwner();
+                async_throw(TimeoutError, f.written);
+            }
+        }
+
+        if (IsClosed())
+        {
+            MYTRACE("W: pipe closed while linking external data");
+            f.ReleaseOwner();
+            async_throw(AbortError, f.written);
+        }
+
+        PipeSegment* seg;
+        if (!f.written)
+        {
+            seg = f.owner;
+        }
+        else if ((mem = MemPoolAlloc<PipeReferencedSegment>()))
+        {
+            seg = new(mem) PipeReferencedSegment(f.owner, (const uint8_t*)data + f.written, std::min(length - f.written, ExternalChunkMax));
+        }
+        else
+        {
+            if (!await_mempool_timeout(PipeReferencedSegment, f.timeout))
+            {
+                f.ReleaseOwner();
+                async_throw(TimeoutError, f.written);
+            }
+            continue;
+        }
+
+        WriterInsert(seg);
+        f.written += seg->length;
+    }
 
+    f.ReleaseOwner();
     async_return(f.written);
 }
 async_end
@@ -202,6 +446,7 @@ void Pipe::WriterInsert(PipeSegment* seg)
             {
                 MYTRACE("W: discarding last %d bytes from current write segment", remaining);
                 apos -= remaining;
+                PIPE_STATS_WASTED(remaining);
             }
             else
             {
@@ -224,6 +469,8 @@ void Pipe::WriterInsert(PipeSegment* seg)
     wpos += seg->length;
     apos += seg->length;
     state++;
+    PIPE_STATS_WRITE(seg->length);
+    PIPE_STATS_PEAK();
     WriterSignal();
 }
 
@@ -252,7 +499,7 @@ async_def(
     while (f.written < length)
     {
         ASSERT(f.seg);
-        while (!to.WriterCanAllocate())
+        while (to.WriterThrottled())
         {
             MYTRACEX("[%p] > [%p] COPY: throttling at %d bytes", &from, &to, to.TotalBytes());
             if (!await_mask_not_timeout(to.state, ~0u, to.state, f.timeout) || to.IsClosed())
@@ -302,7 +549,7 @@ async_def(
 
     while (f.written < length)
     {
-        while (!to.WriterCanAllocate())
+        while (to.WriterThrottled())
         {
             MYTRACEX("[%p] > [%p] MOVE: throttling at %d bytes", &from, &to, to.TotalBytes());
             if (!await_mask_not_timeout(to.state, ~0u, to.state, f.timeout) || to.IsClosed())
@@ -351,6 +598,8 @@ async_end
 async(Pipe::WriterAllocate, size_t hint, Timeout timeout)
 async_def(
     Timeout timeout;
+    size_t hint;
+    AsyncCatchResult res;
 )
 {
     if (IsClosed())
@@ -360,25 +609,58 @@ async_def(
     }
 
     f.timeout = timeout;
+    PIPE_STATS_WAIT_BEGIN(allocateStart);
+
+    // a reader lagging a whole segment behind when the writer needs more space means the pipe is hot
+    // and larger segments save per-segment overhead, a reader keeping up lets the segments shrink back
+    if (ReaderAvailable() >= size_t(256) << (grow * 2))
+    {
+        // 256 << 8 reaches the maximum segment length
+        if (grow < 4)
+            grow++;
+    }
+    else if (IsEmpty() && grow)
+    {
+        grow--;
+    }
 
-    while (!WriterCanAllocate())
+    // a writer allocating ahead of the space it already has gets what it asks for, otherwise
+    // unwritten space in grown segments could pile up beyond the throttle level with nothing to read
+    f.hint = WriterAvailable() ? hint : std::max(hint, grow ? size_t(256) << (grow * 2) : 0);
+    if (throttle)
+    {
+        // a single segment must not hold more than the throttle level allows
+        f.hint = std::min(f.hint, throttle);
+    }
+
+    while (WriterThrottled())
     {
         MYTRACE("W: throttling at %d bytes", TotalBytes());
         if (!await_mask_not_timeout(state, ~0u, state, f.timeout))
         {
             MYTRACE("W: could not allocate new segment, %d bytes in pipe", TotalBytes());
+            PIPE_STATS_WAIT_END(allocateStart, allocateTime);
             async_throw(TimeoutError, 0);
         }
         if (IsClosed())
         {
             MYTRACE("W: pipe closed while waiting for allocation");
+            PIPE_STATS_WAIT_END(allocateStart, allocateTime);
             async_throw(AbortError, 0);
         }
     }
 
-    MYTRACE("W: allocating new segment (hint: %u)", hint);
+    MYTRACE("W: allocating new segment (hint: %u)", f.hint);
+    f.res = await_catch(allocator.AllocateSegment, f.hint, f.timeout);
+    if (!f.res.Success())
+    {
+        MYTRACE("W: allocator failed to provide a segment");
+        PIPE_STATS_WAIT_END(allocateStart, allocateTime);
+        async_rethrow(f.res);
+    }
+
     PipeSegment* seg;
-    seg = (PipeSegment*)await(allocator.AllocateSegment, hint, f.timeout);
+    seg = (PipeSegment*)f.res.Value();
     MYTRACE("W: allocated %u byte segment %p", seg->length, seg);
 
     if (auto* last = *pwseg)
@@ -396,12 +678,47 @@ async_def(
     }
 
     apos += seg->length;
+    // deferred writes are published together with the new segment
+    WriterFlush();
     state++;
+    PIPE_STATS_SEGMENT();
+    PIPE_STATS_PEAK();
+    PIPE_STATS_WAIT_END(allocateStart, allocateTime);
 
     async_return(seg->length);
 }
 async_end
 
+bool Pipe::WriterThrottled()
+{
+    if (WriterCanAllocate())
+    {
+        if (throttled)
+        {
+            MYTRACE("W: resuming at %d bytes", TotalBytes());
+            WriterResume();
+        }
+        return false;
+    }
+
+    // the reader must see everything written before the writer starts waiting for it
+    WriterFlush();
+
+    if (!throttled)
+    {
+        throttled = true;
+        throttleCount++;
+        throttleStart = MONO_CLOCKS;
+    }
+    return true;
+}
+
+void Pipe::WriterResume()
+{
+    throttled = false;
+    throttleTime += MONO_CLOCKS - throttleStart;
+}
+
 void Pipe::WriterAdvance(size_t count)
 {
     ASSERT(*pwseg);
@@ -409,20 +726,129 @@ void Pipe::WriterAdvance(size_t count)
     MYTRACE("W: %u bytes written", count);
     woff += count;
     wpos += count;
-    state++;
-    WriterSignal();
+    PIPE_STATS_WRITE(count);
+    bool filled = false;
     while (woff && woff >= (*pwseg)->length)
     {
         woff -= (*pwseg)->length;
         pwseg = &(*pwseg)->next;
+        filled = true;
+    }
+
+    if (notify == PipeNotify::Immediate)
+    {
+        state++;
+        WriterSignal();
+        return;
+    }
+
+    if (!pending)
+    {
+        pendingSince = MONO_CLOCKS;
+    }
+    pending += count;
+
+    bool due;
+    switch (notify)
+    {
+        case PipeNotify::Bytes: due = pending >= notifyThreshold; break;
+        case PipeNotify::Segment: due = filled; break;
+        case PipeNotify::Latency: due = MONO_CLOCKS - pendingSince >= notifyThreshold; break;
+        default: due = true; break;
+    }
+
+#if KERNEL_SYNC_ONLY
+    // there is no sleep to publish the pending data before
+    due = true;
+#endif
+
+    if (due)
+    {
+        WriterFlush();
     }
+    else
+    {
+        if (!flushScheduler)
+        {
+            MYTRACE("W: deferring notification of %u bytes", pending);
+            flushScheduler = &kernel::Scheduler::Current();
+            flushScheduler->AddPreSleepCallback(this, &Pipe::WriterFlushBeforeSleep);
+        }
+
+#if !KERNEL_SYNC_ONLY
+        // the scheduler may never go to sleep while other tasks are running, the timer enforces the deadline
+        if (notify == PipeNotify::Latency && !latencyTimer)
+        {
+            if (auto mem = MemPoolAlloc<LatencyTimer>())
+            {
+                latencyTimer = new(mem) LatencyTimer { this, pendingSince + notifyThreshold };
+                kernel::Scheduler::Current().Add(&Pipe::WriterLatencyTimer, latencyTimer);
+            }
+        }
+#endif
+    }
+}
+
+void Pipe::WriterFlush()
+{
+    if (flushScheduler)
+    {
+        flushScheduler->RemovePreSleepCallback(this, &Pipe::WriterFlushBeforeSleep);
+        flushScheduler = NULL;
+    }
+
+    if (latencyTimer)
+    {
+        // wakes up the timer task, which releases the timer
+        latencyTimer->pipe = NULL;
+        latencyTimer = NULL;
+    }
+
+    if (pending)
+    {
+        MYTRACE("W: publishing %u bytes", pending);
+        pending = 0;
+        state++;
+        WriterSignal();
+    }
+}
+
+bool Pipe::WriterFlushBeforeSleep(mono_t t, mono_t sleep)
+{
+    // the scheduler removes the callback itself
+    flushScheduler = NULL;
+    WriterFlush();
+    return true;
 }
 
+#if !KERNEL_SYNC_ONLY
+async(Pipe::WriterLatencyTimer, LatencyTimer* timer)
+async_def()
+{
+    if (timer->pipe)
+    {
+        if (!await_mask_not_until(timer->pipe, ~uintptr_t(0), timer->pipe, timer->deadline))
+        {
+            MYTRACEX("[%p] W: latency deadline reached", timer->pipe);
+            timer->pipe->WriterFlush();
+        }
+    }
+    MemPoolFree(timer);
+}
+async_end
+#endif
+
 void Pipe::WriterClose()
 {
     MYTRACE("W: pipe closed @ %u", wpos);
+    WriterFlush();
     pwseg = NULL;
     woff = 0;
+    if (throttled)
+    {
+        // nothing will be written anymore
+        WriterResume();
+    }
     state++;
     WriterSignal();
 
@@ -440,6 +866,7 @@ async_def(
 {
     f.timeout = timeout.MakeAbsolute();
 
+    PIPE_STATS_WAIT_BEGIN(requireStart);
     while (rpos + count > wpos && !IsClosed())
     {
         MYTRACE("R: waiting for data...");
@@ -447,9 +874,11 @@ async_def(
         if (!await_mask_not_timeout(state, ~0u, state, f.timeout))
         {
             MYTRACE("R: %u bytes available instead of %u required", wpos - rpos, count);
+            PIPE_STATS_WAIT_END(requireStart, requireTime);
             async_throw(TimeoutError, wpos - rpos);
         }
     }
+    PIPE_STATS_WAIT_END(requireStart, requireTime);
 
     MYTRACE("R: %u bytes available", wpos - rpos);
     async_return(wpos - rpos);
@@ -531,6 +960,296 @@ async_def(
 }
 async_end
 
+async(Pipe::ReaderRequireUntil, Span needle, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipeSegment* seg;
+    size_t off;
+    PipePosition epos;      //!< All possible match starts before this position have been ruled out
+)
+{
+    if (!needle.Length())
+    {
+        async_return(0);
+    }
+
+    f.timeout = timeout.MakeAbsolute();
+
+    if (size_t(await(ReaderRequire, needle.Length(), f.timeout)) < needle.Length())
+    {
+        async_throw(AbortError, ReaderAvailable());
+    }
+
+    f.seg = rseg;
+    f.off = roff;
+    f.epos = rpos;
+
+    for (;;)
+    {
+        if (size_t(wpos - f.epos) < needle.Length())
+        {
+            // need more data to decide the next start position
+            await(ReaderRequire, f.epos - rpos + needle.Length(), f.timeout);
+            if (size_t(wpos - f.epos) < needle.Length())
+            {
+                async_throw(AbortError, ReaderAvailable());
+            }
+        }
+
+        // move to the current segment
+        while (f.off >= f.seg->length)
+        {
+            f.off -= f.seg->length;
+            f.seg = f.seg->next;
+            ASSERT(f.seg);
+        }
+
+        // number of start positions that can be checked against the available data
+        size_t n = needle.Length();
+        size_t remain = wpos - f.epos - (n - 1);
+        while (remain)
+        {
+            size_t inSeg = std::min(f.seg->length - f.off, size_t(wpos - f.epos));
+            size_t starts = std::min(inSeg, remain);
+            size_t i = 0;
+
+            if (inSeg >= n)
+            {
+                // matches contained in the segment
+                auto p = f.seg->data + f.off;
+                if (auto m = (const uint8_t*)memsearch(p, inSeg, needle.Pointer(), n))
+                {
+                    f.epos += m - p + n;
+                    async_return(f.epos - rpos);
+                }
+                i = inSeg - n + 1;
+            }
+
+            // matches continuing into the following segments
+            for (; i < starts; i++)
+            {
+                if (f.seg->data[f.off + i] == uint8_t(needle[0]) && f.seg->Matches(f.off + i, needle))
+                {
+                    f.epos += i + n;
+                    async_return(f.epos - rpos);
+                }
+            }
+
+            f.epos += starts;
+            if ((remain -= starts))
+            {
+                f.off = 0;
+                f.seg = f.seg->next;
+                ASSERT(f.seg);
+            }
+            else
+            {
+                f.off += starts;
+            }
+        }
+    }
+}
+async_end
+
+async(Pipe::ReaderFindAny, Span set, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipeSegment* seg;
+    size_t off;
+    PipePosition epos;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    if (!rseg)
+    {
+        // read initial data
+        if (!await(ReaderRequire, 1, f.timeout))
+        {
+            async_throw(AbortError, 0);
+        }
+    }
+
+    f.seg = rseg;
+    f.off = roff;
+    f.epos = rpos;
+
+    for (;;)
+    {
+        size_t remain;
+        if (!(remain = (wpos - f.epos)))
+        {
+            // need more data
+            await(ReaderRequire, f.epos - rpos + 1, f.timeout);
+            if (!(remain = (wpos - f.epos)))
+            {
+                async_throw(AbortError, f.epos - rpos);
+            }
+        }
+
+        // move to the current segment
+        while (f.off >= f.seg->length)
+        {
+            f.off -= f.seg->length;
+            f.seg = f.seg->next;
+            ASSERT(f.seg);
+        }
+
+        // process available data
+        while (remain)
+        {
+            size_t len = std::min(remain, f.seg->length - f.off);
+            const uint8_t* p;
+            if ((p = (const uint8_t*)memfindany(f.seg->data + f.off, len, set.Pointer(), set.Length())))
+            {
+                // found a match
+                f.epos += p - (f.seg->data + f.off) + 1;
+                async_return(f.epos - rpos);
+            }
+
+            // move to next segment
+            f.epos += len;
+            if ((remain -= len))
+            {
+                f.off = 0;
+                f.seg = f.seg->next;
+                ASSERT(f.seg);
+            }
+            else
+            {
+                f.off += len;
+            }
+        }
+    }
+}
+async_end
+
+async(Pipe::ReaderContiguous, size_t count, Timeout timeout)
+async_def(
+    Timeout timeout;
+    PipeReferencedSegment* split;
+    AsyncCatchResult res;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    await(ReaderRequire, count, f.timeout);
+
+    if (Span(ReaderSpan(0)).Length() >= std::min(count, ReaderAvailable()))
+    {
+        // already contiguous
+        async_return(Span(ReaderSpan(0)).Length());
+    }
+
+    // the tail of the last merged segment may have to stay in the pipe, prepare a segment referencing it
+    while (!(f.split = MemPoolAlloc<PipeReferencedSegment>()))
+    {
+        if (!await_mempool_timeout(PipeReferencedSegment, f.timeout))
+        {
+            async_throw(TimeoutError, 0);
+        }
+    }
+
+    MYTRACE("R: allocating %u byte segment to merge leading segments", count);
+    f.res = await_catch(allocator.AllocateSegment, count, f.timeout);
+    if (!f.res.Success())
+    {
+        MemPoolFree<PipeReferencedSegment>(f.split);
+        async_rethrow(f.res);
+    }
+
+    auto merged = (PipeSegment*)f.res.Value();
+    size_t n = std::min(count, ReaderAvailable());
+    if (merged->length < n)
+    {
+        MYTRACE("R: allocated segment too small (%u < %u)", merged->length, n);
+        size_t max = merged->length;
+        merged->Release();
+        MemPoolFree<PipeReferencedSegment>(f.split);
+        async_throw(AbortError, max);
+    }
+
+    // copy the leading segments up to the one containing the last requested byte
+    auto dst = (uint8_t*)merged->data;
+    size_t copied = 0;
+    PipeSegment* seg = rseg;
+    PipeSegment* next;
+    size_t off = roff;
+    for (;;)
+    {
+        // only the written part matters, space after it is either still being written or abandoned by a closed writer
+        size_t len = std::min(seg->length - off, ReaderAvailable() - copied);
+        if (copied + len < n)
+        {
+            memcpy(dst + copied, seg->data + off, len);
+            copied += len;
+            seg = seg->next;
+            off = 0;
+            continue;
+        }
+
+        bool writing = pwseg && *pwseg == seg;
+        if (!writing && copied + len <= merged->length)
+        {
+            // the rest of the segment fits as well, it can be released entirely
+            memcpy(dst + copied, seg->data + off, len);
+            copied += len;
+            apos -= seg->length - off - len;
+            PIPE_STATS_WASTED(seg->length - off - len);
+            next = seg->next;
+            if (pwseg == &seg->next)
+            {
+                pwseg = &merged->next;
+            }
+        }
+        else
+        {
+            // keep the rest of the segment, including any space still being written
+            size_t split = off + n - copied;
+            memcpy(dst + copied, seg->data + off, n - copied);
+            copied = n;
+            next = new(f.split) PipeReferencedSegment(seg, seg->data + split, seg->length - split);
+            f.split = NULL;
+            next->next = seg->next;
+            if (writing)
+            {
+                pwseg = &merged->next;
+                woff -= split;
+            }
+            else if (pwseg == &seg->next)
+            {
+                pwseg = &next->next;
+            }
+        }
+        break;
+    }
+
+    // release the merged segments, up to and including the last one
+    auto end = seg->next;
+    for (seg = rseg; seg != end;)
+    {
+        auto release = seg;
+        seg = seg->next;
+        release->next = NULL;
+        release->Release();
+    }
+
+    MYTRACE("R: merged %u bytes into segment %p", copied, merged);
+    merged->length = copied;
+    merged->next = next;
+    rseg = merged;
+    roff = 0;
+    state++;
+
+    if (f.split)
+    {
+        MemPoolFree<PipeReferencedSegment>(f.split);
+    }
+
+    async_return(Span(ReaderSpan(0)).Length());
+}
+async_end
+
 async(Pipe::ReaderRead, char* data, size_t length, Timeout timeout)
 async_def()
 {
@@ -561,6 +1280,7 @@ Span::packed_t Pipe::ReaderRead(char* buffer, size_t count)
     MYTRACE("R: %u bytes read", count);
     rpos += count;
     state++;
+    PIPE_STATS_READ(count);
 
     auto bufferStart = buffer;
     size_t remain = rseg->length - roff;
@@ -635,6 +1355,21 @@ Span::packed_t Pipe::ReaderRead(char* buffer, size_t count)
     return Span(bufferStart, buffer);
 }
 
+size_t Pipe::ReaderSpans(Span* spans, size_t max, size_t length) const
+{
+    length = std::min(length, ReaderAvailable());
+    size_t n = 0, offset = roff;
+    for (auto seg = rseg; length && n < max; seg = seg->next)
+    {
+        ASSERT(seg);
+        size_t block = std::min(length, seg->length - offset);
+        spans[n++] = Span(seg->data + offset, block);
+        length -= block;
+        offset = 0;
+    }
+    return n;
+}
+
 int Pipe::ReaderPeek(size_t offset) const
 {
     offset += roff;
@@ -756,4 +1491,42 @@ Buffer::packed_t Pipe::Iterator::ReadImpl(char* buffer, size_t length)
     return res;
 }
 
+size_t Pipe::Iterator::CountLines()
+{
+    size_t lines = 0;
+    ForEachSpan([&](Span span) { lines += memcount(span.Pointer(), span.Length(), '\n'); });
+    return lines;
+}
+
+size_t Pipe::Iterator::Mismatch(Span data)
+{
+    auto d = (const uint8_t*)data.Pointer();
+    auto de = d + data.Length();
+    return ForEachSpan([&](Span span)
+    {
+        auto p = (const uint8_t*)span.Pointer();
+        size_t len = std::min(span.Length(), size_t(de - d));
+        if (!memcmp(p, d, len))
+        {
+            d += len;
+            return len;
+        }
+        size_t i = 0;
+        while (p[i] == d[i])
+        {
+            i++;
+        }
+        return i;
+    });
+}
+
+size_t Pipe::Iterator::SkipAny(Span set)
+{
+    return ForEachSpan([&](Span span)
+    {
+        auto p = (const char*)memskipany(span.Pointer(), span.Length(), set.Pointer(), set.Length());
+        return p ? size_t(p - (const char*)span.Pointer()) : span.Length();
+    });
+}
+
 }
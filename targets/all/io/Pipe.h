@@ -11,14 +11,48 @@
 #include <kernel/kernel.h>
 
 #include <base/Span.h>
+#include <base/Delegate.h>
 
 #include <io/PipeSegment.h>
 #include <io/PipeAllocator.h>
 #include <io/PipePosition.h>
 
+#if PIPE_STATS
+#include <base/format.h>
+#endif
+
 namespace io
 {
 
+//! Policies for waking up the reader after data is written to a pipe
+//! Deferred writes are also published whenever the pipe changes otherwise (e.g. a segment is allocated
+//! or the pipe is closed), before the writer is held by throttling and when the scheduler is about to sleep
+enum struct PipeNotify : uint8_t
+{
+    Immediate,      //!< Every write wakes up the reader (default)
+    Bytes,          //!< The reader is woken up once the threshold number of bytes is pending
+    Segment,        //!< The reader is woken up when a segment is filled
+    Latency,        //!< The reader is woken up threshold MONO_CLOCKS after the first pending write
+};
+
+#if PIPE_STATS
+//! Counters collected for each pipe when PIPE_STATS is enabled
+//! The byte counters wrap around, throughput is measured as the difference between two snapshots
+struct PipeStats
+{
+    const char* name;       //!< Name under which the pipe is registered, NULL if it is not
+    uint32_t written;       //!< Total bytes written
+    uint32_t read;          //!< Total bytes read
+    uint32_t segments;      //!< Number of segments allocated by the writer
+    uint32_t peak;          //!< Maximum number of bytes allocated in the pipe at the same time
+    uint32_t changes;       //!< Number of changes of the pipe state, each one can wake up the reader or the writer
+    uint32_t throttleCount; //!< Number of times writes have been held because the throttle level was reached
+    mono_t throttleTime;    //!< Total time writes have been held, in MONO_CLOCKS
+    mono_t allocateTime;    //!< Total time the writer spent waiting for new segments, including throttling, in MONO_CLOCKS
+    mono_t requireTime;     //!< Total time the reader spent waiting for data, in MONO_CLOCKS
+};
+#endif
+
 class Pipe
 {
 public:
@@ -29,7 +63,13 @@ public:
 
     ~Pipe()
     {
+        // only unregister the pending notification, there is nobody to notify anymore
+        pending = 0;
+        WriterFlush();
         Cleanup();
+#if PIPE_STATS
+        Unregister();
+#endif
     }
 
     size_t Unprocessed() const { return wpos - rpos; }
@@ -45,7 +85,36 @@ public:
     async_once(Change, Timeout timeout = Timeout::Infinite) { return async_forward(WaitMaskNot, state, ~0u, state, timeout); }
     void Reset();
     size_t ThrottleLevel() const { return throttle; }
-    void ThrottleLevel(size_t bytes) { throttle = bytes; }
+    //! Sets the level at which writes are held, they resume after the pipe drains to half of it
+    void ThrottleLevel(size_t bytes) { ThrottleLevel(bytes, bytes / 2); }
+    //! Sets the level at which writes are held and the level to which the pipe must drain before they resume
+    void ThrottleLevel(size_t high, size_t low) { throttle = high; resume = std::min(low, high); }
+    size_t ResumeLevel() const { return resume; }
+    //! Gets the number of times writes have been held because the throttle level was reached
+    uint32_t ThrottleCount() const { return throttleCount; }
+    //! Gets the total time writes have been held, in MONO_CLOCKS
+    mono_t ThrottleTime() const { return throttleTime + (throttled ? MONO_CLOCKS - throttleStart : 0); }
+    //! Sets when the reader is woken up after data is written, the threshold is in bytes or MONO_CLOCKS depending on the policy
+    void NotifyPolicy(PipeNotify policy, uint32_t threshold = 0) { WriterFlush(); notify = policy; notifyThreshold = threshold; }
+    PipeNotify NotifyPolicy() const { return notify; }
+
+#if PIPE_STATS
+    //! Registers the pipe under the specified name, making it enumerable until it is destroyed
+    void Register(const char* name);
+    //! Removes the pipe from the list of registered pipes
+    void Unregister();
+    //! Gets the name under which the pipe is registered
+    const char* Name() const { return name; }
+    //! Gets the most recently registered pipe
+    static Pipe* First() { return s_first; }
+    //! Gets the next registered pipe
+    Pipe* Next() const { return next; }
+    //! Gets a snapshot of the counters of the pipe
+    PipeStats Stats() const { return { name, written, read, segments, peak, uint32_t(state), ThrottleCount(), ThrottleTime(), allocateTime, requireTime }; }
+
+    //! Writes the counters of all registered pipes as a JSON array
+    static int DumpJson(format_output output, void* context);
+#endif
 
     class SpanIterator
     {
@@ -127,6 +196,65 @@ public:
 
         ALWAYS_INLINE constexpr SpanIterator Spans() const { return SpanIterator(seg, seg->length + segRemaining, remaining); }
 
+        //! Calls @p fn with each contiguous span of the remaining data, advancing past the bytes it processes
+        //! The callback returns the number of bytes processed, the iteration stops when it is less than the length
+        //! of the span; callbacks returning nothing process all the data
+        //! @returns the number of bytes processed
+        template<typename TFn> size_t ForEachSpan(TFn fn)
+        {
+            size_t total = 0;
+            while (remaining)
+            {
+                Span span(segEnd + segRemaining, std::min(remaining, size_t(-segRemaining)));
+                size_t n;
+                if constexpr (std::is_void<decltype(fn(span))>::value)
+                {
+                    fn(span);
+                    n = span.Length();
+                }
+                else
+                {
+                    n = fn(span);
+                }
+                Skip(n);
+                total += n;
+                if (n < span.Length())
+                {
+                    break;
+                }
+            }
+            return total;
+        }
+
+        //! Advances over the bytes for which @p pred holds, leaving the iterator at the first one for which it does not
+        //! The bytes are tested span by span, without checking for segment boundaries after each one
+        //! @returns the number of bytes skipped
+        template<typename TPred> size_t Scan(TPred pred)
+        {
+            return ForEachSpan([&](Span span)
+            {
+                auto p = (const uint8_t*)span.Pointer();
+                auto e = p + span.Length();
+                while (p < e && pred(*p))
+                {
+                    p++;
+                }
+                return size_t(p - (const uint8_t*)span.Pointer());
+            });
+        }
+
+        //! Counts the line feeds in the remaining data, consuming it
+        size_t CountLines();
+        //! Advances over the bytes matching @p data
+        //! @returns the offset of the first byte that differs, the number of bytes compared if all of them match
+        size_t Mismatch(Span data);
+        //! Advances over the bytes present in @p set, a vectorized equivalent of Scan for small sets
+        //! @returns the number of bytes skipped
+        size_t SkipAny(Span set);
+        //! Advances over spaces, tabs and line breaks
+        //! @returns the number of bytes skipped
+        size_t SkipWhitespace() { return SkipAny(" \t\n\v\f\r"); }
+
     private:
         constexpr Iterator(PipeSegment* seg, size_t offset, size_t remaining)
             : seg(seg), segEnd(seg->data + seg->length), segRemaining(offset - seg->length), remaining(remaining) {}
@@ -142,6 +270,14 @@ public:
     };
 
 private:
+    //! Link between the pipe and the task publishing its pending writes at the deadline of the Latency policy,
+    //! the pipe detaches itself when it publishes the writes earlier or goes away
+    struct LatencyTimer
+    {
+        Pipe* pipe;
+        mono_t deadline;
+    };
+
     PipeAllocator& allocator;       //!< Allocator used for new segments
     PipeSegment* rseg = NULL;       //!< Pointer to the current read segment (head)
     size_t roff = 0;                //!< Offset into the current read segment
@@ -153,6 +289,27 @@ private:
     size_t state = 0;               //!< Incremented every time pipe state changes
     bool* wsignal = NULL;           //!< External signal activated when new data is written to the pipe
     size_t throttle = 1024;         //!< Hold writes above this threshold
+    size_t resume = 512;            //!< Release held writes at or below this threshold
+    bool throttled = false;         //!< Writes are held until the pipe drains to the resume level
+    uint32_t throttleCount = 0;     //!< Number of times writes have been held
+    mono_t throttleStart = 0;       //!< Time when writes were last held
+    mono_t throttleTime = 0;        //!< Total time writes have been held, excluding the current period
+    PipeNotify notify = PipeNotify::Immediate;  //!< When the reader is woken up after data is written
+    uint32_t notifyThreshold = 0;   //!< Parameter of the notify policy
+    size_t pending = 0;             //!< Bytes written but not yet published to the reader
+    mono_t pendingSince = 0;        //!< Time of the first write not yet published
+    kernel::Scheduler* flushScheduler = NULL;   //!< Scheduler that publishes pending writes before going to sleep
+    LatencyTimer* latencyTimer = NULL;  //!< Timer publishing pending writes at the deadline of the Latency policy
+    uint8_t grow = 0;               //!< Segment size level, raised while the reader lags behind the writer
+#if PIPE_STATS
+    const char* name = NULL;        //!< Name under which the pipe is registered
+    Pipe* next = NULL;              //!< Next pipe in the list of registered pipes
+    uint32_t written = 0, read = 0, segments = 0, peak = 0;
+    mono_t allocateTime = 0, requireTime = 0;
+    mono_t allocateStart, requireStart;    //!< Start of the current wait of the writer and the reader
+
+    static Pipe* s_first;
+#endif
 
     void Cleanup();
 
@@ -160,7 +317,10 @@ private:
     PipePosition WriterAllocatedPosition() const { return apos; }
     size_t WriterAvailable() const { return apos - wpos; }
     size_t WriterAvailableAfter(PipePosition position) const { ASSERT(position >= wpos); return position.LengthUntil(apos); }
-    bool WriterCanAllocate() const { return !throttle || TotalBytes() < throttle; }
+    bool WriterCanAllocate() const { return !throttle || (throttled ? TotalBytes() <= resume : TotalBytes() < throttle); }
+    //! Checks whether the writer has to wait for the reader, keeping track of the periods when writes are held
+    bool WriterThrottled();
+    void WriterResume();
     bool WriterCanWrite() const { return WriterAvailable() || WriterCanAllocate(); }
     //! Allocates a new block, throwing an error on timeout or if the pipe is closed
     async(WriterAllocate, size_t block, Timeout timeout);
@@ -168,9 +328,22 @@ private:
     async(WriterWrite, const char* data, size_t length, Timeout timeout);
     //! Writes formatted data to the pipe, throwing an error unless the data is written in full
     async(WriterWriteFV, Timeout timeout, const char* format, va_list va);
+    //! Writes data gathered from multiple parts to the pipe, throwing an error unless the data is written in full
+    //! The parts array must remain valid until the operation completes
+    async(WriterWriteV, const Span* parts, size_t count, Timeout timeout);
+    //! Links external data into the pipe without copying, throwing an error unless the data is linked in full
+    //! The release callback is invoked exactly once, after the last byte has been consumed or when the write fails
+    async(WriterWriteExternal, const char* data, size_t length, Delegate<void, Span> release, Timeout timeout);
     Buffer::packed_t WriterBuffer(size_t offset) const;
     Buffer WriterBufferAt(PipePosition position) { return WriterBuffer(wpos.LengthUntil(position)); }
     void WriterAdvance(size_t count);
+    //! Wakes up the reader if any written data has not been published to it yet
+    void WriterFlush();
+    bool WriterFlushBeforeSleep(mono_t t, mono_t sleep);
+#if !KERNEL_SYNC_ONLY
+    //! Publishes the pending writes at the deadline unless the pipe does so earlier and detaches the timer
+    static async(WriterLatencyTimer, LatencyTimer* timer);
+#endif
     void WriterAdvanceTo(PipePosition position) { if (auto count = wpos.LengthUntil(position)) WriterAdvance(count); }
     void WriterInsert(PipeSegment* seg);
     void WriterClose();
@@ -184,6 +357,18 @@ private:
     async(ReaderRequire, size_t count, Timeout timeout);
     //! Waits until the specified byte appears in the stream, throwing an error on timeout
     async(ReaderRequireUntil, uint8_t b, Timeout timeout);
+    //! Waits until the byte sequence appears in the stream, throwing an error on timeout
+    //! The match may span multiple segments, the needle must remain valid until the operation completes
+    //! @returns the number of bytes up to and including the end of the first match
+    async(ReaderRequireUntil, Span needle, Timeout timeout);
+    //! Waits until any of the bytes in the set appears in the stream, throwing an error on timeout
+    //! @returns the number of bytes up to and including the first matching byte
+    async(ReaderFindAny, Span set, Timeout timeout);
+    //! Waits until the required number of bytes is available and makes them contiguous, throwing an error on timeout
+    //! If they span multiple segments, the leading segments are merged into one new segment from the allocator,
+    //! throwing AbortError if the allocator cannot provide a segment large enough
+    //! @returns the length of the contiguous span at the read position, less than requested only when the stream is closed
+    async(ReaderContiguous, size_t count, Timeout timeout);
     //! Reads up to the specified number of bytes from the pipes
     async(ReaderRead, char* buffer, size_t length, Timeout timeout);
     Span::packed_t ReaderSpan(size_t offset) const;
@@ -192,6 +377,7 @@ private:
     void ReaderAdvance(size_t count) { ReaderRead(NULL, count); }
     void ReaderAdvanceTo(PipePosition position) { if (auto count = rpos.LengthUntil(position)) ReaderAdvance(count); }
     bool ReaderComplete() const { return IsClosed(); }
+    size_t ReaderSpans(Span* spans, size_t max, size_t length) const;
     int ReaderPeek(size_t offset) const;
     Span::packed_t ReaderPeek(char * buffer, size_t length, size_t offset) const;
     size_t ReaderLengthUntil(PipePosition position) const { return rpos.LengthUntil(position); }
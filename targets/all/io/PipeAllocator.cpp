@@ -15,6 +15,14 @@
 #define MYTRACE(...)
 #endif
 
+#if PIPE_STATS
+#define PIPE_STATS_ALLOCATED()      ({ PipeAllocator::s_stats.allocated++; })
+#define PIPE_STATS_RECYCLED()       ({ PipeAllocator::s_stats.recycled++; })
+#else
+#define PIPE_STATS_ALLOCATED()
+#define PIPE_STATS_RECYCLED()
+#endif
+
 namespace io
 {
 
@@ -45,11 +53,13 @@ private:
     }
 };
 
+//! Segment of an arbitrary size allocated directly using malloc
 class DynamicPipeSegment : PipeSegment
 {
 public:
-    static PipeSegment* TryAlloc(size_t size, const uintptr_t*& mon)
+    static PipeSegment* TryAlloc(size_t size)
     {
+        MYTRACE("Allocating %d-byte dynamic segment", size);
         if (auto mem = malloc(size + sizeof(DynamicPipeSegment)))
         {
             return new(mem) DynamicPipeSegment(size);
@@ -70,13 +80,75 @@ private:
     }
 };
 
+//! Payload sizes of large segment buckets grow by 4x, starting at 1K and clipped to the maximum segment length
+static constexpr size_t BucketPayload(unsigned bucket) { return std::min(size_t(1024) << (bucket * 2), size_t(PIPE_SEGMENT_MAX)); }
+static constexpr unsigned BucketCount() { unsigned n = 1; while (BucketPayload(n - 1) < PIPE_SEGMENT_MAX) { n++; } return n; }
+
+//! Large segment with a payload size given by its bucket, released segments are kept for reuse
+class BucketPipeSegment : PipeSegment
+{
+public:
+    static constexpr size_t Payload(unsigned bucket) { return BucketPayload(bucket); }
+    static constexpr unsigned Buckets() { return BucketCount(); }
+
+    static PipeSegment* TryAlloc(unsigned bucket)
+    {
+        auto& cache = s_cache[bucket];
+        void* mem = cache.first;
+        if (mem)
+        {
+            MYTRACE("Recycling %d-byte segment", Payload(bucket));
+            cache.first = cache.first->nextFree;
+            cache.count--;
+            PIPE_STATS_RECYCLED();
+        }
+        else if (!(mem = malloc(sizeof(BucketPipeSegment) + Payload(bucket))))
+        {
+            return NULL;
+        }
+
+        return new(mem) BucketPipeSegment(bucket);
+    }
+
+private:
+    BucketPipeSegment(unsigned bucket)
+        : PipeSegment((const uint8_t*)(this + 1), Payload(bucket)), bucket(bucket)
+    {
+    }
+
+    virtual void Destroy()
+    {
+        auto& cache = s_cache[bucket];
+        if (cache.count < PIPE_SEGMENT_CACHE)
+        {
+            nextFree = cache.first;
+            cache.first = this;
+            cache.count++;
+        }
+        else
+        {
+            free(this);
+        }
+    }
+
+    uint8_t bucket;
+    BucketPipeSegment* nextFree;
+
+    static struct Cache
+    {
+        BucketPipeSegment* first;
+        size_t count;
+    } s_cache[BucketCount()];
+};
+
+BucketPipeSegment::Cache BucketPipeSegment::s_cache[BucketCount()];
+
 class DefaultPipeAllocator : public PipeAllocator
 {
     enum
     {
         PoolPayload64 = 64 - sizeof(PoolPipeSegment<64>),
         PoolPayloadMax = MEMPOOL_MAX_SIZE - sizeof(PoolPipeSegment<MEMPOOL_MAX_SIZE>),
-        DynamicPayloadMax = 1024,
     };
 
 public:
@@ -125,25 +197,54 @@ public:
 private:
     static PipeSegment* TryAllocateSegment(size_t hint, const uintptr_t*& mon)
     {
-        if (hint <= PoolPayload64)
+        PipeSegment* seg = NULL;
+        if (hint < BucketPipeSegment::Payload(0))
         {
-            return PoolPipeSegment<64>::TryAlloc(mon);
+            if (hint > PoolPayloadMax)
+            {
+                seg = DynamicPipeSegment::TryAlloc(hint);
+            }
         }
-
-        if (hint <= PoolPayloadMax)
+        else
         {
-            return PoolPipeSegment<MEMPOOL_MAX_SIZE>::TryAlloc(mon);
+            // the largest bucket not exceeding the hint, so that segments stay within the throttle level of the pipe
+            unsigned bucket = 0;
+            while (bucket + 1 < BucketPipeSegment::Buckets() && BucketPipeSegment::Payload(bucket + 1) <= hint)
+            {
+                bucket++;
+            }
+
+            // smaller buckets are tried when large blocks cannot be allocated
+            while (!(seg = BucketPipeSegment::TryAlloc(bucket)) && bucket)
+            {
+                MYTRACE("Failed to allocate %d-byte segment", BucketPipeSegment::Payload(bucket));
+                bucket--;
+            }
         }
 
-        if (hint > DynamicPayloadMax)
-            hint = DynamicPayloadMax;
+        // the pools are the last resort, they also provide a location to monitor for released blocks
+        if (!seg && hint > PoolPayload64)
+        {
+            seg = PoolPipeSegment<MEMPOOL_MAX_SIZE>::TryAlloc(mon);
+        }
+        if (!seg)
+        {
+            seg = PoolPipeSegment<64>::TryAlloc(mon);
+        }
 
-        return DynamicPipeSegment::TryAlloc(hint, mon);
+        if (seg)
+        {
+            PIPE_STATS_ALLOCATED();
+        }
+        return seg;
     }
 };
 
 static DefaultPipeAllocator defaultAllocator;
 
 PipeAllocator* PipeAllocator::s_default = &defaultAllocator;
+#if PIPE_STATS
+PipeAllocatorStats PipeAllocator::s_stats;
+#endif
 
 }
@@ -12,19 +12,61 @@
 
 #include <io/Errors.h>
 
+#ifndef PIPE_SEGMENT_MAX
+// largest segment payload provided by the default allocator, segment lengths are 16-bit
+// so this cannot exceed 65535; large blocks are scarce on anything but the host
+#if Thost
+#define PIPE_SEGMENT_MAX        65535
+#else
+#define PIPE_SEGMENT_MAX        1024
+#endif
+#endif
+
+#ifndef PIPE_SEGMENT_CACHE
+// number of released large segments kept for reuse by the default allocator in each size bucket
+#define PIPE_SEGMENT_CACHE      4
+#endif
+
+#ifndef PIPE_STATS
+// collect per-pipe throughput and wait counters and the allocator segment counters,
+// see Pipe::Stats() and PipeAllocator::Stats()
+#define PIPE_STATS      0
+#endif
+
 namespace io
 {
 
+#if PIPE_STATS
+//! Segment counters collected when PIPE_STATS is enabled, see PipeAllocator::Stats()
+struct PipeAllocatorStats
+{
+    uint32_t allocated;     //!< Segments provided by the default allocator
+    uint32_t recycled;      //!< Segments of those that were reused from the caches instead of being allocated anew
+    uint32_t wasted;        //!< Bytes left unwritten at the tails of segments cut or released by pipes, regardless of the allocator that provided them
+};
+#endif
+
 class PipeAllocator
 {
 public:
     //! Allocates a new segment, throws if timeout expires before a new segment can be allocated
     virtual async(AllocateSegment, size_t hint, Timeout timeout) = 0;
 
+#if PIPE_STATS
+    //! Gets a snapshot of the segment counters
+    static PipeAllocatorStats Stats() { return s_stats; }
+
+protected:
+    static PipeAllocatorStats s_stats;
+#endif
+
 private:
     static PipeAllocator* s_default;
 
     friend class Pipe;
+    friend class BucketPipeSegment;
+    friend class PipeBudget;
+    friend class MulticastPipe;
 };
 
 }
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/PipeBudget.cpp
+ */
+
+#include <io/PipeBudget.h>
+
+#include <base/MemPoolAsync.h>
+
+#if PIPE_TRACE
+#define MYTRACE(fmt, ...)        DBGCL("pipequota", "[%p] " fmt, this, ## __VA_ARGS__)
+#else
+#define MYTRACE(...)
+#endif
+
+namespace io
+{
+
+//! Wraps the segments provided by the underlying allocator, returning the charged bytes to the quota when released
+class PipeQuota::Segment : public PipeSegment
+{
+public:
+    Segment(PipeQuota* quota, PipeSegment* inner, const uint8_t* data, size_t length)
+        : PipeSegment(data, length), quota(quota), inner(inner), charged(length)
+    {
+    }
+
+private:
+    virtual void Destroy()
+    {
+        auto quota = this->quota;
+        auto inner = this->inner;
+        auto charged = this->charged;
+        MemPoolFree<Segment>(this);
+        inner->Release();
+        quota->Refund(charged);
+    }
+
+    PipeQuota* quota;
+    PipeSegment* inner;
+    size_t charged;     //!< The length of the segment can be cut by the pipe, remember what was charged for it
+};
+
+PipeQuota::PipeQuota(PipeBudget& budget, size_t min, size_t max)
+    : budget(budget), min(min), max(std::max(min, max))
+{
+    ASSERT(budget.used + budget.reserved + min <= budget.budget);
+    budget.reserved += min;
+}
+
+PipeQuota::~PipeQuota()
+{
+    ASSERT(!used && !waiting);
+    budget.reserved -= Unused();
+}
+
+size_t PipeQuota::Allowance() const
+{
+    size_t own = used < max ? max - used : 0;
+    // the part of the budget that is neither used nor reserved for the minimums of other quotas
+    size_t taken = budget.used + budget.reserved - Unused();
+    size_t shared = taken < budget.budget ? budget.budget - taken : 0;
+    return std::min(own, shared);
+}
+
+void PipeQuota::Charge(size_t bytes)
+{
+    budget.reserved -= Unused();
+    used += bytes;
+    budget.used += bytes;
+    budget.reserved += Unused();
+}
+
+void PipeQuota::Refund(size_t bytes)
+{
+    if (!bytes)
+    {
+        return;
+    }
+
+    MYTRACE("returning %u bytes to budget", bytes);
+    budget.reserved -= Unused();
+    used -= bytes;
+    budget.used -= bytes;
+    budget.reserved += Unused();
+    budget.state++;
+}
+
+void PipeQuota::Enqueue()
+{
+    if (!waiting)
+    {
+        MYTRACE("waiting for budget, %u bytes used", budget.used);
+        waiting = true;
+        waitNext = NULL;
+        *budget.waitTail = this;
+        budget.waitTail = &waitNext;
+    }
+}
+
+void PipeQuota::Dequeue()
+{
+    if (!waiting)
+    {
+        return;
+    }
+
+    auto pp = &budget.waitHead;
+    while (*pp != this)
+    {
+        pp = &(*pp)->waitNext;
+    }
+    if (!(*pp = waitNext))
+    {
+        budget.waitTail = pp;
+    }
+    waiting = false;
+    // the next quota in the queue may be able to proceed
+    budget.state++;
+}
+
+PipeSegment* PipeQuota::Wrap(void* mem, PipeSegment* seg)
+{
+    return new(mem) Segment(this, seg, seg->data, seg->length);
+}
+
+async(PipeQuota::AllocateSegment, size_t hint, Timeout timeout)
+async_def(
+    Timeout timeout;
+    size_t charge;
+    Segment* mem;
+    AsyncCatchResult res;
+)
+{
+    f.timeout = timeout.MakeAbsolute();
+
+    while (!(f.mem = MemPoolAlloc<Segment>()))
+    {
+        if (!await_mempool_timeout(Segment, f.timeout))
+        {
+            async_throw(TimeoutError, 0);
+        }
+    }
+
+    for (;;)
+    {
+        size_t allowance = Allowance();
+        // the guaranteed minimum is not waited for in turn, the shared part of the budget goes
+        // to waiting quotas one allocation at a time, in the order in which they started waiting
+        if (allowance && (used < min || !budget.waitHead || budget.waitHead == this))
+        {
+            f.charge = std::min(std::max(hint, size_t(1)), allowance);
+            break;
+        }
+
+        if (used < max)
+        {
+            Enqueue();
+        }
+
+        if (!await_mask_not_timeout(budget.state, ~0u, budget.state, f.timeout))
+        {
+            MYTRACE("timeout waiting for budget");
+            Dequeue();
+            MemPoolFree<Segment>(f.mem);
+            async_throw(TimeoutError, 0);
+        }
+    }
+
+    Dequeue();
+
+    // charge the allowance before allocating, so that it cannot be claimed by others while the allocator waits
+    Charge(f.charge);
+    f.res = await_catch(budget.allocator.AllocateSegment, f.charge, f.timeout);
+    if (!f.res.Success())
+    {
+        Refund(f.charge);
+        MemPoolFree<Segment>(f.mem);
+        async_rethrow(f.res);
+    }
+
+    auto seg = (PipeSegment*)f.res.Value();
+    // the allocator may round the size either way, the actual segment length is what counts
+    if (seg->length > f.charge)
+    {
+        Charge(seg->length - f.charge);
+    }
+    else
+    {
+        Refund(f.charge - seg->length);
+    }
+
+    MYTRACE("allocated %u byte segment, %u bytes used", seg->length, used);
+    async_return(intptr_t(Wrap(f.mem, seg)));
+}
+async_end
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/PipeBudget.h
+ *
+ * Memory budget shared by a group of pipes. Each pipe allocates through its
+ * own PipeQuota, which guarantees it a minimum share of the budget and limits
+ * it to a maximum. Writers waiting for the shared part of the budget are
+ * served in turns as memory is released.
+ *
+ * Quotas charge the actual length of the segments they obtain, so the limits
+ * can be exceeded by the rounding of the underlying allocator in the last
+ * segment allocated.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeAllocator.h>
+#include <io/PipeSegment.h>
+
+namespace io
+{
+
+class PipeQuota;
+
+class PipeBudget
+{
+public:
+    //! Creates a budget of the specified number of bytes, allocating segments from the specified allocator
+    PipeBudget(size_t budget, PipeAllocator& allocator = *PipeAllocator::s_default)
+        : allocator(allocator), budget(budget)
+    {
+    }
+
+    //! Gets the total number of bytes in the budget
+    size_t Budget() const { return budget; }
+    //! Gets the number of bytes in segments currently allocated by all quotas
+    size_t Used() const { return used; }
+    //! Gets the number of bytes reserved for the minimums of quotas that have not used them up
+    size_t Reserved() const { return reserved; }
+
+private:
+    PipeAllocator& allocator;
+    size_t budget;
+    size_t used = 0;                //!< Bytes charged to all quotas
+    size_t reserved = 0;            //!< Unused parts of all quota minimums
+    size_t state = 0;               //!< Incremented every time memory is released or the wait queue changes
+    PipeQuota* waitHead = NULL;     //!< First quota waiting for the shared part of the budget
+    PipeQuota** waitTail = &waitHead;
+
+    friend class PipeQuota;
+};
+
+//! Allocator of a single pipe drawing from a shared PipeBudget
+//! Both the quota and the budget must outlive the pipes using them
+class PipeQuota : public PipeAllocator
+{
+public:
+    //! Creates a quota guaranteed @p min bytes of the budget and limited to @p max bytes
+    PipeQuota(PipeBudget& budget, size_t min = 0, size_t max = ~size_t(0));
+    ~PipeQuota();
+
+    //! Gets the number of bytes in segments currently allocated through the quota
+    size_t Used() const { return used; }
+    size_t Minimum() const { return min; }
+    size_t Maximum() const { return max; }
+
+    //! Allocates a segment of at most the remaining allowance of the quota,
+    //! waiting in turn with other quotas when the shared part of the budget is exhausted
+    virtual async(AllocateSegment, size_t hint, Timeout timeout);
+
+private:
+    class Segment;
+
+    PipeBudget& budget;
+    size_t min, max;
+    size_t used = 0;
+    PipeQuota* waitNext = NULL;
+    bool waiting = false;
+
+    //! Part of the minimum not used yet
+    size_t Unused() const { return used < min ? min - used : 0; }
+    //! Number of bytes the quota can allocate right now
+    size_t Allowance() const;
+    void Charge(size_t bytes);
+    void Refund(size_t bytes);
+    void Enqueue();
+    void Dequeue();
+    PipeSegment* Wrap(void* mem, PipeSegment* seg);
+};
+
+}
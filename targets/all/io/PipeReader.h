@@ -31,6 +31,11 @@ public:
 
     async(Require, size_t count = 1, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderRequire, count, timeout); }
     async(RequireUntil, uint8_t b, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderRequireUntil, b, timeout); }
+    async(RequireUntil, Span needle, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderRequireUntil, needle, timeout); }
+    async(FindAny, Span set, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderFindAny, set, timeout); }
+    //! Waits for @p count bytes and merges them into a single segment if needed, so GetSpan returns all of them
+    //! @returns the length of the span returned by GetSpan
+    async(Contiguous, size_t count, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderContiguous, count, timeout); }
     async(Read, Buffer buffer, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->ReaderRead, buffer.Pointer(), buffer.Length(), timeout); }
     async(CopyTo, io::PipeWriter writer, size_t offset, size_t count, Timeout timeout = Timeout::Infinite);
     async(MoveTo, io::PipeWriter writer, size_t count, Timeout timeout = Timeout::Infinite);
@@ -38,6 +43,9 @@ public:
     async_once(Change, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->Change, timeout); }
     Span GetSpan(size_t offset = 0) const { ASSERT(pipe); return pipe->ReaderSpan(offset); }
     Span GetSpanAt(PipePosition position) { ASSERT(pipe); return pipe->ReaderSpanAt(position); }
+    //! Fills the array with up to @p max spans covering up to @p length available bytes (e.g. for writev)
+    //! @returns the number of spans filled
+    size_t GetSpans(Span* spans, size_t max, size_t length = ~size_t(0)) const { ASSERT(pipe); return pipe->ReaderSpans(spans, max, length); }
     Span Read(Buffer buffer) { ASSERT(pipe); return pipe->ReaderRead(buffer.Pointer(), buffer.Length()); }
     void Advance(size_t count) { ASSERT(pipe); pipe->ReaderAdvance(count); }
     void AdvanceTo(PipePosition position) { ASSERT(pipe); pipe->ReaderAdvanceTo(position); }
@@ -52,6 +60,8 @@ public:
 
     size_t ThrottleLevel() const { ASSERT(pipe); return pipe->ThrottleLevel(); }
     void ThrottleLevel(size_t bytes) const { ASSERT(pipe); pipe->ThrottleLevel(bytes); }
+    void ThrottleLevel(size_t high, size_t low) const { ASSERT(pipe); pipe->ThrottleLevel(high, low); }
+    size_t ResumeLevel() const { ASSERT(pipe); return pipe->ResumeLevel(); }
 
     bool Matches(Span data, size_t offset = 0) const { ASSERT(pipe); return pipe->ReaderMatches(data, offset); }
 
@@ -61,6 +71,11 @@ public:
     ALWAYS_INLINE constexpr Pipe::Iterator Enumerate(size_t length) const { ASSERT(pipe); return pipe->ReaderIteratorBegin(length); }
     ALWAYS_INLINE constexpr Pipe::SpanIterator EnumerateSpans(size_t length) const { ASSERT(pipe); return pipe->ReaderSpanIteratorBegin(length); }
 
+    //! Calls @p fn with each contiguous span of up to @p length available bytes, see Pipe::Iterator::ForEachSpan
+    //! The reader is not advanced
+    //! @returns the number of bytes processed
+    template<typename TFn> size_t ForEachSpan(size_t length, TFn fn) const { return Available() ? Enumerate(length).ForEachSpan(fn) : 0; }
+
     constexpr operator bool() const { return pipe; }
 
 private:
@@ -35,6 +35,7 @@ private:
     uint16_t refs;
 
     friend class Pipe;
+    friend class PipeQuota;
 };
 
 }
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/PipeStage.cpp
+ */
+
+#include <io/PipeStage.h>
+
+#if PIPE_TRACE
+#define MYTRACE(fmt, ...)        DBGCL("pipeline", "[%p] " fmt, this, ## __VA_ARGS__)
+#else
+#define MYTRACE(...)
+#endif
+
+namespace io
+{
+
+async(PipeStage::Finish, PipeWriter output)
+async_def()
+{
+}
+async_end
+
+async(PipePassthrough::Process, Pipe::SpanIterator input, PipeWriter output)
+async_def(
+    size_t length;
+)
+{
+    f.length = input.Available();
+    await(Forward, output, 0, f.length);
+    async_return(f.length);
+}
+async_end
+
+Pipeline& Pipeline::Add(PipeStage& stage)
+{
+    ASSERT(!stage.next && last != &stage.next);
+    *last = &stage;
+    last = &stage.next;
+    return *this;
+}
+
+async(Pipeline::Run, PipeReader input, PipeWriter output)
+async_def(
+    PipeStage* stage;
+    PipeWriter out;
+    bool progress;
+    size_t consumed;
+    PipePosition start;
+    mono_t t0, held;
+)
+{
+    ASSERT(first);
+
+    for (auto stage = first, prev = (PipeStage*)NULL; stage; prev = stage, stage = stage->next)
+    {
+        stage->input = prev ? PipeReader(prev->pipe) : input;
+        stage->unconsumed = 0;
+        stage->done = false;
+        // the pipes between the stages are drained by the same task that fills them, they must not hold it
+        stage->pipe.Reset();
+        stage->pipe.ThrottleLevel(0);
+    }
+
+    for (;;)
+    {
+        f.progress = false;
+
+        // each pass moves new data through all the stages
+        for (f.stage = first; f.stage; f.stage = f.stage->next)
+        {
+            if (f.stage->done)
+            {
+                continue;
+            }
+
+            f.out = f.stage->next ? PipeWriter(f.stage->pipe) : output;
+
+            if (f.stage->input.Available() > f.stage->unconsumed)
+            {
+                f.t0 = MONO_CLOCKS;
+                f.held = f.out.ThrottleTime();
+                f.start = f.out.Position();
+
+                f.consumed = await(f.stage->Process, f.stage->input.EnumerateSpans(f.stage->input.Available()), f.out);
+                ASSERT(f.consumed <= f.stage->input.Available());
+                f.stage->input.Advance(f.consumed);
+                f.stage->unconsumed = f.stage->input.Available();
+
+                f.stage->stats.in += f.consumed;
+                f.stage->stats.out += f.out.Position() - f.start;
+                f.stage->stats.time += (MONO_CLOCKS - f.t0) - (f.out.ThrottleTime() - f.held);
+                f.stage->stats.calls++;
+                f.progress = true;
+            }
+
+            if (f.stage->input.IsComplete() && f.stage->input.Available() == f.stage->unconsumed)
+            {
+                MYTRACE("stage %p finishing, %u bytes unconsumed", f.stage, f.stage->unconsumed);
+                f.t0 = MONO_CLOCKS;
+                f.held = f.out.ThrottleTime();
+                f.start = f.out.Position();
+
+                await(f.stage->Finish, f.out);
+                f.stage->input.Advance(f.stage->input.Available());
+
+                f.stage->stats.out += f.out.Position() - f.start;
+                f.stage->stats.time += (MONO_CLOCKS - f.t0) - (f.out.ThrottleTime() - f.held);
+                f.stage->done = true;
+                f.out.Close();
+                f.progress = true;
+            }
+        }
+
+        if (!f.progress)
+        {
+            if (first->done)
+            {
+                break;
+            }
+            // the stages past the first one are fed within the pass, only the first can be starved
+            await(first->input.Require, first->unconsumed + 1);
+        }
+    }
+}
+async_end
+
+}
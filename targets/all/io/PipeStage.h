@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/PipeStage.h
+ *
+ * Transformations between pipes as stages chained into a pipeline that runs
+ * as a single task. Each stage sees the spans of its input that are available
+ * and writes its results to the output, which is the input of the next stage.
+ * Data passed through unchanged is forwarded by reference, without copying.
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+namespace io
+{
+
+//! Stage counters, see PipeStage::Stats()
+struct PipeStageStats
+{
+    uint64_t in;            //!< Input bytes consumed
+    uint64_t out;           //!< Output bytes produced
+    mono_t time;            //!< MONO_CLOCKS spent in the stage, excluding the time writes to the output were held
+    uint32_t calls;         //!< Number of times the stage processed new input
+};
+
+class PipeStage
+{
+public:
+    //! Processes the available input, covered by the spans, writing the results to @p output
+    //! @returns the number of input bytes consumed, the rest is presented again together with more input
+    virtual async(Process, Pipe::SpanIterator input, PipeWriter output) = 0;
+    //! Called once the input completes and everything has been presented to Process,
+    //! input left unconsumed is still available through Input() and discarded afterwards
+    virtual async(Finish, PipeWriter output);
+
+    const PipeStageStats& Stats() const { return stats; }
+
+protected:
+    //! Gets the reader of the input, valid while the stage is processing
+    PipeReader Input() const { return input; }
+    //! Passes part of the input to the output by reference to its segments, without copying the data
+    async(Forward, PipeWriter output, size_t offset, size_t length) { return async_forward(input.CopyTo, output, offset, length, Timeout::Infinite); }
+
+private:
+    PipeStage* next = NULL;
+    PipeReader input;
+    Pipe pipe;              //!< Feeds the next stage
+    size_t unconsumed;      //!< Input left by the last call to Process
+    bool done;
+    PipeStageStats stats = {};
+
+    friend class Pipeline;
+};
+
+//! Stage forwarding all of its input unchanged
+class PipePassthrough : public PipeStage
+{
+public:
+    virtual async(Process, Pipe::SpanIterator input, PipeWriter output);
+};
+
+class Pipeline
+{
+public:
+    //! Appends a stage to the pipeline, stages must not be shared between pipelines
+    Pipeline& Add(PipeStage& stage);
+
+    //! Passes all data from @p input through the stages to @p output, closing the output once the input completes
+    async(Run, PipeReader input, PipeWriter output);
+
+private:
+    PipeStage* first = NULL;
+    PipeStage** last = &first;
+};
+
+}
@@ -34,10 +34,29 @@ public:
     size_t Available() const { ASSERT(pipe); return pipe->WriterAvailable(); }
     size_t AvailableAfter(PipePosition pos) const { ASSERT(pipe); return pipe->WriterAvailableAfter(pos); }
     bool CanAllocate() const { ASSERT(pipe); return pipe->WriterCanAllocate(); }
+    size_t ThrottleLevel() const { ASSERT(pipe); return pipe->ThrottleLevel(); }
+    void ThrottleLevel(size_t bytes) const { ASSERT(pipe); pipe->ThrottleLevel(bytes); }
+    void ThrottleLevel(size_t high, size_t low) const { ASSERT(pipe); pipe->ThrottleLevel(high, low); }
+    size_t ResumeLevel() const { ASSERT(pipe); return pipe->ResumeLevel(); }
+    uint32_t ThrottleCount() const { ASSERT(pipe); return pipe->ThrottleCount(); }
+    //! Gets the total time writes have been held by the throttle level, in MONO_CLOCKS
+    mono_t ThrottleTime() const { ASSERT(pipe); return pipe->ThrottleTime(); }
+    //! Sets when the reader is woken up after data is written, see @ref PipeNotify
+    void NotifyPolicy(PipeNotify policy, uint32_t threshold = 0) const { ASSERT(pipe); pipe->NotifyPolicy(policy, threshold); }
+    //! Wakes up the reader immediately if there is written data it has not been notified about
+    void Flush() const { ASSERT(pipe); pipe->WriterFlush(); }
     //! Allocates a new block, throwing an error on timeout or if the pipe is closed
     async(Allocate, size_t block, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->WriterAllocate, block, timeout); }
     //! Writes data to the pipe, throwing an error unless data can be written in full
     async(Write, Span data, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->WriterWrite, data.Pointer(), data.Length(), timeout); }
+    //! Writes data gathered from multiple parts to the pipe, allocating space for all of it at once
+    //! The parts array must remain valid until the operation completes, throws an error unless data can be written in full
+    async(WriteV, const Span* parts, size_t count, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->WriterWriteV, parts, count, timeout); }
+    //! Links caller-owned memory into the pipe without copying, throwing an error unless it can be linked in full
+    //! The @p release callback is invoked exactly once, when the reader has consumed all of the data or the write fails
+    async(WriteExternal, Span data, Delegate<void, Span> release, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->WriterWriteExternal, data.Pointer(), data.Length(), release, timeout); }
+    //! Links constant data into the pipe without copying, throwing an error unless it can be linked in full
+    async(WriteStatic, Span data, Timeout timeout = Timeout::Infinite) { ASSERT(pipe); return async_forward(pipe->WriterWriteExternal, data.Pointer(), data.Length(), {}, timeout); }
     //! Writes a formatted string to the pipe, throwing an error unless it can be written in full
     async(WriteF, const char* format, ...) async_def_va(WriteFV, format, Timeout::Infinite, format);
     //! Writes a formatted string to the pipe, throwing an error unless it can be written in full within the specified timeout
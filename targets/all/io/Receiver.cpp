@@ -90,8 +90,9 @@ async_def(
     {
         while (TryAddBuffers())
         {
-            // allocate a new block
-            if (!await(pipe.Allocate, blockHint))
+            // allocate a new block, this fails if the pipe gets closed in the meantime
+            auto res = await_catch(pipe.Allocate, blockHint);
+            if (!res.Success() || !res.Value())
             {
                 break;
             }
@@ -112,6 +113,12 @@ async_def(
     while (!pipe.IsClosed())
     {
         f.TryAdvance();
+        if (IsEndOfStream())
+        {
+            // everything received has been written, nothing more will come
+            pipe.Close();
+            break;
+        }
         f.Allocate();
 
         if (auto p = f.TryAdvance())
@@ -35,6 +35,8 @@ protected:
     virtual async_once(Wait, const char* current, Timeout timeout = Timeout::Infinite) = 0;
     //! Stop the reader, any added buffers may be deallocated after returning
     virtual async_once(Close) = 0;
+    //! Checks if the source has ended, the pipe is closed after all data received so far is written
+    virtual bool IsEndOfStream() { return false; }
 
 public:
     //! Meant to run as a task to fill the specified pipe until it's closed
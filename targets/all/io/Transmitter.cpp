@@ -37,7 +37,8 @@ async_def(
     {
         for (;;)
         {
-            auto span = pipe.GetSpan();
+            // only the data already added to the transmitter can be considered sent
+            auto span = pipe.GetSpan().Left(pipe.LengthUntil(pos));
             if (!span.Length())
             {
                 // no more data to send
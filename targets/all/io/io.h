@@ -17,6 +17,12 @@
 #include <io/PipeReader.h>
 #include <io/PipeWriter.h>
 #include <io/DuplexPipe.h>
+#include <io/PipeBudget.h>
+#include <io/MulticastPipe.h>
+#include <io/Lz4.h>
+#include <io/Lzss.h>
+#include <io/PipeStage.h>
+#include <io/Framer.h>
 
 #include <io/Receiver.h>
 #include <io/Transmitter.h>
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/bench/Compression.cpp
+ *
+ * Measures the compression stages on telemetry-like data
+ *
+ * Each codec adds rows with the compression and decompression throughput
+ * in MB/s of uncompressed data, and the compressed size in percent of the
+ * original, in the duration column
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// amount of uncompressed data
+constexpr size_t Length = 256 * 1024;
+
+struct S
+{
+    // JSON records of a few slowly changing sensors, the kind of payload the links carry
+    static async(Telemetry, PipeWriter w, bool binary)
+    async_def(
+        size_t written, n, i;
+        char line[96];
+    )
+    {
+        while (f.written < Length)
+        {
+            if (binary)
+            {
+                // the same readings as fixed-size little endian records
+                uint32_t rec[6] = { uint32_t(1700000000 + f.i), uint32_t(2000 + f.i % 37), uint32_t(4000 + f.i % 13 * 3), uint32_t(101325 - f.i % 11), uint32_t(f.i % 100 ? 0 : 1), uint32_t(f.i) };
+                memcpy(f.line, rec, f.n = sizeof(rec));
+            }
+            else
+            {
+                f.n = sprintf(f.line, "{\"t\":%u,\"temp\":%u.%02u,\"hum\":%u.%u,\"press\":%u,\"state\":\"%s\"}\n",
+                    unsigned(1700000000 + f.i), unsigned(20 + f.i % 37 / 10), unsigned(f.i * 7 % 100), unsigned(40 + f.i % 13), unsigned(f.i % 10),
+                    unsigned(101325 - f.i % 11), f.i % 100 ? "ok" : "alarm");
+            }
+            f.n = std::min(f.n, Length - f.written);
+            await(w.Write, Span(f.line, f.n));
+            f.written += f.n;
+            f.i++;
+        }
+        w.Close();
+    }
+    async_end
+};
+
+template<typename TEncoder, typename TDecoder> void Measure(const char* codec, TEncoder& encoder, TDecoder& decoder, bool binary)
+{
+    Scheduler s;
+    Pipe plain, compressed, decompressed;
+    plain.ThrottleLevel(0);
+    compressed.ThrottleLevel(0);
+    decompressed.ThrottleLevel(0);
+
+    s.Add(&S::Telemetry, plain, binary);
+    s.Run();
+
+    auto t0 = MONO_US;
+    s.Add(encoder, &TEncoder::Run, plain, compressed);
+    s.Run();
+    uint32_t compress = MONO_US - t0;
+    size_t size = PipeReader(compressed).Available();
+
+    t0 = MONO_US;
+    s.Add(decoder, &TDecoder::Run, compressed, decompressed);
+    s.Run();
+    uint32_t decompress = MONO_US - t0;
+
+    PipeReader r(decompressed);
+    AssertEqual(r.Available(), Length);
+    r.Advance(r.Available());
+
+    TestCase::ReportThroughput(Length, compress, "%s compress", codec);
+    TestCase::ReportThroughput(Length, decompress, "%s decompress", codec);
+    TestCase::ReportMetric(uint64_t(size) * 100000 / Length, "%", "%s size", codec);
+}
+
+TEST_CASE("01 LZ4")
+{
+    Lz4Decoder decoder;
+    {
+        Lz4Encoder encoder(4096);
+        Measure("LZ4 4k JSON", encoder, decoder, false);
+        Measure("LZ4 4k binary", encoder, decoder, true);
+    }
+    {
+        Lz4Encoder encoder(65536);
+        Measure("LZ4 64k JSON", encoder, decoder, false);
+        Measure("LZ4 64k binary", encoder, decoder, true);
+    }
+}
+
+TEST_CASE("02 LZSS")
+{
+    LzssDecoder decoder;
+    for (unsigned bits: { 8, 10, 12 })
+    {
+        char name[32];
+        LzssEncoder encoder(bits);
+        sprintf(name, "LZSS %u JSON", 1u << bits);
+        Measure(name, encoder, decoder, false);
+        sprintf(name, "LZSS %u binary", 1u << bits);
+        Measure(name, encoder, decoder, true);
+    }
+}
+
+}
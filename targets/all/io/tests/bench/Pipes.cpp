@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/bench/Pipes.cpp
+ *
+ * Measures the throughput of the basic pipe operations, from chunked writes
+ * and reads through segment moves to receivers and transmitters driven by
+ * a mock DMA strategy
+ *
+ * Each case adds rows to the result table named "<operation> <parameter>
+ * [<unit>]", with the throughput in MB/s and the time per operation in ns
+ * in the duration column, so the results of successive runs can be compared
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// amount of data transferred by each measurement
+constexpr size_t Length = 1024 * 1024;
+// number of times the data is copied or moved, these only reference the segments
+constexpr size_t Rounds = 256;
+
+//! Reports the throughput and, if there were separate operations, the time per operation
+void Report(const char* what, unsigned param, uint32_t us, size_t ops = 0, uint64_t bytes = Length)
+{
+    TestCase::ReportThroughput(bytes, us, "%s %u", what, param);
+    if (ops)
+    {
+        TestCase::ReportMetric(uint64_t(us) * 1000000 / ops, "ns/op", "%s %u", what, param);
+    }
+}
+
+//! Runs all the tasks added to the scheduler, measuring the time it takes
+uint32_t Measure(Scheduler& s)
+{
+    auto t0 = MONO_US;
+    s.Run();
+    return MONO_US - t0;
+}
+
+// source of the written data
+char data[65536];
+// string formatted into the pipes
+char text[4001];
+
+struct S
+{
+    static async(Writer, PipeWriter w, size_t chunk, size_t length)
+    async_def(
+        size_t written, n;
+    )
+    {
+        while (f.written < length)
+        {
+            // the data wraps around at the end of the source, keeping the records aligned
+            f.n = std::min({ chunk, length - f.written, sizeof(data) - f.written % sizeof(data) });
+            await(w.Write, Span(data + f.written % sizeof(data), f.n));
+            f.written += f.n;
+        }
+        w.Close();
+    }
+    async_end
+
+    static async(Reader, PipeReader r, size_t chunk)
+    async_def(
+        size_t read;
+        char buf[4096];
+    )
+    {
+        while (size_t n = await(r.Read, Buffer(f.buf, std::min(chunk, sizeof(f.buf)))))
+        {
+            f.read += n;
+        }
+        AssertEqual(f.read, Length);
+    }
+    async_end
+
+    static async(Drain, PipeReader r, size_t* read)
+    async_def()
+    {
+        while (await(r.Require, 1))
+        {
+            *read += r.Available();
+            r.Advance(r.Available());
+        }
+    }
+    async_end
+
+    static async(Copy, PipeReader r, Pipe* dst)
+    async_def(
+        size_t round;
+    )
+    {
+        for (f.round = 0; f.round < Rounds; f.round++)
+        {
+            await(r.CopyTo, *dst, 0, Length);
+            PipeReader(*dst).Advance(Length);
+        }
+    }
+    async_end
+
+    //! Forwards the data through a chain of pipes, as a pipeline of stages passing it on would
+    static async(Move, Pipe* chain)
+    async_def(
+        size_t round;
+    )
+    {
+        for (f.round = 0; f.round < Rounds; f.round++)
+        {
+            await(PipeReader(chain[f.round]).MoveTo, chain[f.round + 1], Length);
+        }
+    }
+    async_end
+
+    static async(Records, PipeReader r, size_t* count)
+    async_def()
+    {
+        while (size_t n = await(r.RequireUntil, "\r\n"))
+        {
+            r.Advance(n);
+            (*count)++;
+        }
+    }
+    async_end
+
+    static async(Format, PipeWriter w, bool wide, size_t* count)
+    async_def(
+        size_t written;
+    )
+    {
+        while (f.written < Length)
+        {
+            if (wide)
+            {
+                // a long string spanning several segments
+                f.written += await(w.WriteF, "%s\n", text);
+            }
+            else
+            {
+                f.written += await(w.WriteF, "{\"seq\":%u,\"value\":%d,\"state\":\"%s\"}\n", unsigned(*count), int(*count * 37 % 1000) - 500, *count % 10 ? "ok" : "alarm");
+            }
+            (*count)++;
+        }
+        w.Close();
+    }
+    async_end
+
+    //! Reads from all the pipes as data arrives, until all of them complete
+    static async(FanIn, Pipe* pipes, size_t count)
+    async_def(
+        size_t read;
+    )
+    {
+        for (;;)
+        {
+            bool open = false, any = false;
+            for (size_t i = 0; i < count; i++)
+            {
+                PipeReader r(pipes[i]);
+                if (size_t n = r.Available())
+                {
+                    f.read += n;
+                    r.Advance(n);
+                    any = true;
+                }
+                open |= !pipes[i].IsCompleted();
+            }
+            if (!open)
+            {
+                break;
+            }
+            if (!any)
+            {
+                async_yield();
+            }
+        }
+        AssertEqual(f.read, Length);
+    }
+    async_end
+};
+
+void Init()
+{
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        // printable data, with line breaks every 64 bytes for the record scanning
+        data[i] = i % 64 == 62 ? '\r' : i % 64 == 63 ? '\n' : 'A' + i % 26;
+    }
+    memcpy(text, data, sizeof(text) - 1);
+}
+
+TEST_CASE("01 Write Read")
+{
+    Init();
+    for (size_t chunk: { 16, 64, 256, 1024, 4096 })
+    {
+        Scheduler s;
+        Pipe p;
+        p.ThrottleLevel(16384);
+        s.Add(&S::Writer, p, chunk, Length);
+        s.Add(&S::Reader, p, chunk);
+        Report("Write/Read chunk", chunk, Measure(s), Length / chunk);
+    }
+}
+
+TEST_CASE("02 Segment Sizes")
+{
+    Init();
+    // the throttle level caps the length of the segments taken from the default allocator,
+    // covering its small pools as well as the large buckets
+    for (size_t segment: { 64, 256, 1024, 4096, 16384, 65535 })
+    {
+        Scheduler s;
+        Pipe p;
+        p.ThrottleLevel(segment);
+        size_t read = 0;
+#if PIPE_STATS
+        auto before = PipeAllocator::Stats();
+#endif
+        s.Add(&S::Writer, p, size_t(1024), Length);
+        s.Add(&S::Drain, p, &read);
+        auto us = Measure(s);
+        AssertEqual(read, Length);
+#if PIPE_STATS
+        Report("Write/Drain segment", segment, us, PipeAllocator::Stats().allocated - before.allocated);
+#else
+        Report("Write/Drain segment", segment, us);
+#endif
+    }
+}
+
+TEST_CASE("03 Copy Move")
+{
+    Init();
+    for (size_t chunk: { 256, 4096, 65536 })
+    {
+        Scheduler s;
+        auto chain = new Pipe[Rounds + 1];
+        Pipe& src = chain[0];
+        Pipe dst;
+        for (size_t i = 0; i <= Rounds; i++)
+        {
+            chain[i].ThrottleLevel(0);
+        }
+        dst.ThrottleLevel(0);
+
+        // the source is filled ahead, its segments grow up to the write size
+        s.Add(&S::Writer, src, chunk, Length);
+        s.Run();
+        size_t segments = 0;
+        for (UNUSED Span span: PipeReader(src).EnumerateSpans(Length))
+        {
+            segments++;
+        }
+
+        // the time per operation is per segment copied or moved
+        s.Add(&S::Copy, src, &dst);
+        Report("Copy chunk", chunk, Measure(s), segments * Rounds, uint64_t(Length) * Rounds);
+        s.Add(&S::Move, chain);
+        Report("Move chunk", chunk, Measure(s), segments * Rounds, uint64_t(Length) * Rounds);
+        AssertEqual(PipeReader(chain[Rounds]).Available(), Length);
+        PipeReader(chain[Rounds]).Advance(Length);
+        delete[] chain;
+    }
+}
+
+TEST_CASE("04 RequireUntil")
+{
+    Init();
+    size_t records = 0;
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(16384);
+    s.Add(&S::Writer, p, size_t(1024), Length);
+    s.Add(&S::Records, p, &records);
+    auto us = Measure(s);
+    AssertEqual(records, Length / 64);
+    Report("RequireUntil record", 64, us, records);
+}
+
+TEST_CASE("05 WriteF")
+{
+    Init();
+    for (bool wide: { false, true })
+    {
+        size_t count = 0, read = 0;
+        Scheduler s;
+        Pipe p;
+        p.ThrottleLevel(16384);
+        s.Add(&S::Format, p, wide, &count);
+        s.Add(&S::Drain, p, &read);
+        auto us = Measure(s);
+        AssertGreaterOrEqual(read, Length);
+        Report(wide ? "WriteF string" : "WriteF record", wide ? 4000 : 3, us, count);
+    }
+}
+
+TEST_CASE("06 Fan In")
+{
+    Init();
+    for (size_t count: { 1, 4, 16, 64 })
+    {
+        Scheduler s;
+        auto pipes = new Pipe[count];
+        for (size_t i = 0; i < count; i++)
+        {
+            pipes[i].ThrottleLevel(4096);
+            s.Add(&S::Writer, pipes[i], size_t(256), Length / count);
+        }
+        s.Add(&S::FanIn, pipes, count);
+        Report("Fan-in pipes", count, Measure(s), Length / 256);
+        delete[] pipes;
+    }
+}
+
+//! Receiver strategy standing in for a double-buffered DMA, each wait transfers a burst of data
+class DmaReceiver : public Receiver
+{
+public:
+    DmaReceiver(size_t burst)
+        : burst(burst) {}
+
+protected:
+    size_t TryAddBuffer(size_t offset, Buffer buffer) override
+    {
+        if (count == MaxBuffers || total == Length)
+        {
+            return 0;
+        }
+        buffers[(head + count++) % MaxBuffers] = buffer;
+        return buffer.Length();
+    }
+
+    const char* GetWritePointer(Buffer buffer) override { return Current(); }
+
+    async_once(Wait, const char* current, Timeout timeout) override
+    {
+        size_t n = std::min(burst, Length - total);
+        while (n && count)
+        {
+            auto& buf = buffers[head];
+            size_t block = std::min(n, buf.Length() - filled);
+            memcpy(buf.Pointer() + filled, data + total % (sizeof(data) - burst), block);
+            total += block;
+            n -= block;
+            if ((filled += block) == buf.Length())
+            {
+                filled = 0;
+                head = (head + 1) % MaxBuffers;
+                count--;
+            }
+        }
+        async_once_return(true);
+    }
+
+    async_once(Close) override
+    {
+        count = 0;
+        filled = 0;
+        async_once_return(0);
+    }
+
+    bool IsEndOfStream() override { return total == Length; }
+
+private:
+    enum { MaxBuffers = 2 };
+
+    Buffer buffers[MaxBuffers];
+    uint8_t head = 0, count = 0;
+    size_t burst, filled = 0, total = 0;
+
+    const char* Current() const { return count ? buffers[head].Pointer() + filled : NULL; }
+};
+
+//! Transmitter strategy standing in for a double-buffered DMA, each wait sends a burst of data
+class DmaTransmitter : public Transmitter
+{
+public:
+    DmaTransmitter(size_t burst)
+        : burst(burst) {}
+
+protected:
+    size_t TryAddBlock(Span block) override
+    {
+        if (count == MaxBlocks)
+        {
+            return 0;
+        }
+        blocks[(head + count++) % MaxBlocks] = block;
+        return block.Length();
+    }
+
+    const char* GetReadPointer() override { return Current(); }
+
+    async_once(Wait, const char* current, Timeout timeout) override
+    {
+        size_t n = burst;
+        while (n && count)
+        {
+            auto& block = blocks[head];
+            size_t part = std::min(n, block.Length() - sent);
+            n -= part;
+            if ((sent += part) == block.Length())
+            {
+                last = block.end();
+                sent = 0;
+                head = (head + 1) % MaxBlocks;
+                count--;
+            }
+        }
+        async_once_return(true);
+    }
+
+private:
+    enum { MaxBlocks = 2 };
+
+    Span blocks[MaxBlocks];
+    uint8_t head = 0, count = 0;
+    size_t burst, sent = 0;
+    const char* last = NULL;
+
+    const char* Current() const { return count ? blocks[head].Pointer() + sent : last; }
+};
+
+TEST_CASE("07 Receiver Transmitter")
+{
+    Init();
+    // the receiver and transmitter run helper tasks on the main scheduler
+    auto& s = Scheduler::Main();
+    for (size_t burst: { 64, 512, 4096 })
+    {
+        Pipe p;
+        p.ThrottleLevel(16384);
+        size_t read = 0;
+        DmaReceiver rx(burst);
+        rx.StartReceiveToPipe(p, 1024);
+        s.Add(&S::Drain, p, &read);
+        Report("Receiver burst", burst, Measure(s), Length / burst);
+        AssertEqual(read, Length);
+        Assert(p.IsCompleted());
+    }
+
+    for (size_t burst: { 64, 512, 4096 })
+    {
+        Pipe p;
+        p.ThrottleLevel(16384);
+        DmaTransmitter tx(burst);
+        s.Add(&S::Writer, p, size_t(1024), Length);
+        tx.StartTransmitFromPipe(p);
+        Report("Transmitter burst", burst, Measure(s), Length / burst);
+        Assert(p.IsCompleted());
+    }
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/bench/Scan.cpp
+ *
+ * Compares the span-wise scanning kernels of pipe iterators against
+ * per-byte iterator loops over data spread across many segments
+ *
+ * Each case adds a row to the result table, with the scanning throughput
+ * in MB/s (not milliseconds) in the duration column
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// amount of data scanned
+constexpr size_t Length = 256 * 1024;
+// number of times the data is scanned
+constexpr size_t Rounds = 16;
+
+// amount of data processed by each measurement
+constexpr uint64_t Total = uint64_t(Length) * Rounds;
+
+bool IsSpace(uint8_t c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+struct S
+{
+    // log-like text lines, or whitespace only for the skipping cases
+    static async(Fill, PipeWriter w, bool blank)
+    async_def(
+        size_t written, n;
+        char line[72];
+    )
+    {
+        while (f.written < Length)
+        {
+            f.n = std::min(sizeof(f.line), Length - f.written);
+            for (size_t i = 0; i < f.n; i++)
+            {
+                f.line[i] = i == f.n - 1 ? '\n' : blank ? " \t"[i & 1] : i % 9 == 8 ? ' ' : 'a' + (f.written + i) % 26;
+            }
+            await(w.Write, Span(f.line, f.n));
+            f.written += f.n;
+        }
+    }
+    async_end
+};
+
+template<typename TLoop> uint32_t MeasureLoop(bool blank, TLoop loop, size_t expect)
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+    s.Add(&S::Fill, p, blank);
+    s.Run();
+
+    auto t0 = MONO_US;
+    PipeReader r(p);
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        AssertEqual(loop(r), expect);
+    }
+    uint32_t us = MONO_US - t0;
+    r.Advance(r.Available());
+    return us;
+}
+
+constexpr size_t Lines = (Length + 71) / 72;
+
+TEST_CASE("01 Count Lines")
+{
+    TestCase::ReportThroughput(Total, MeasureLoop(false, [](PipeReader r) { return r.Enumerate(Length).CountLines(); }, Lines), "CountLines");
+    TestCase::ReportThroughput(Total, MeasureLoop(false, [](PipeReader r)
+    {
+        size_t n = 0;
+        for (char c: r)
+        {
+            n += c == '\n';
+        }
+        return n;
+    }, Lines), "Iterator lines");
+}
+
+TEST_CASE("02 Skip Whitespace")
+{
+    TestCase::ReportThroughput(Total, MeasureLoop(true, [](PipeReader r) { return r.Enumerate(Length).SkipWhitespace(); }, Length), "SkipWhitespace");
+    TestCase::ReportThroughput(Total, MeasureLoop(true, [](PipeReader r) { return r.Enumerate(Length).Scan(IsSpace); }, Length), "Scan whitespace");
+    TestCase::ReportThroughput(Total, MeasureLoop(true, [](PipeReader r)
+    {
+        auto it = r.begin();
+        while (it && IsSpace(*it))
+        {
+            ++it;
+        }
+        return size_t(it - r.begin());
+    }, Length), "Iterator whitespace");
+}
+
+TEST_CASE("03 Mismatch")
+{
+    static char expected[Length];
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+    s.Add(&S::Fill, p, false);
+    s.Run();
+    PipeReader(p).Enumerate(Length).Read(Buffer(expected, Length));
+    PipeReader(p).Advance(Length);
+
+    TestCase::ReportThroughput(Total, MeasureLoop(false, [](PipeReader r) { return r.Enumerate(Length).Mismatch(Span(expected, Length)); }, Length), "Mismatch");
+    TestCase::ReportThroughput(Total, MeasureLoop(false, [](PipeReader r)
+    {
+        size_t n = 0;
+        for (auto it = r.begin(); it && *it == expected[n]; ++it)
+        {
+            n++;
+        }
+        return n;
+    }, Length), "Iterator mismatch");
+}
+
+}
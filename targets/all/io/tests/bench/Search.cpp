@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/bench/Search.cpp
+ *
+ * Compares the vectorized pipe searches against per-byte iterator loops
+ *
+ * Each case adds a row to the result table, with the scanning throughput
+ * in MB/s (not milliseconds) in the duration column
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// amount of data preceding the match
+constexpr size_t Length = 256 * 1024;
+// number of times the data is searched
+constexpr size_t Rounds = 16;
+
+// amount of data processed by each measurement
+constexpr uint64_t Total = uint64_t(Length) * Rounds;
+
+struct S
+{
+    // header-like text without the searched terminators
+    static async(Fill, PipeWriter w, Span tail)
+    async_def(
+        size_t written, n;
+        char line[64];
+    )
+    {
+        while (f.written < Length)
+        {
+            f.n = std::min(sizeof(f.line), Length - f.written);
+            for (size_t i = 0; i < f.n; i++)
+            {
+                f.line[i] = i == f.n - 1 ? '\r' : 'A' + (f.written + i) % 26;
+            }
+            await(w.Write, Span(f.line, f.n));
+            f.written += f.n;
+        }
+        await(w.Write, tail);
+    }
+    async_end
+
+    static async(RequireUntil, PipeReader r, Span needle, uint32_t* us)
+    async_def(
+        mono_t t0;
+        size_t round;
+    )
+    {
+        f.t0 = MONO_US;
+        for (f.round = 0; f.round < Rounds; f.round++)
+        {
+            AssertEqual(size_t(await(r.RequireUntil, needle)), Length + needle.Length());
+        }
+        *us = MONO_US - f.t0;
+    }
+    async_end
+
+    static async(FindAny, PipeReader r, Span set, uint32_t* us)
+    async_def(
+        mono_t t0;
+        size_t round;
+    )
+    {
+        f.t0 = MONO_US;
+        for (f.round = 0; f.round < Rounds; f.round++)
+        {
+            AssertEqual(size_t(await(r.FindAny, set)), Length + 1);
+        }
+        *us = MONO_US - f.t0;
+    }
+    async_end
+};
+
+template<typename TSearch> uint32_t Measure(Span tail, TSearch search)
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+    s.Add(&S::Fill, p, tail);
+    s.Run();
+
+    uint32_t us;
+    search(s, p, &us);
+    s.Run();
+    PipeReader r(p);
+    r.Advance(r.Available());
+    return us;
+}
+
+size_t IteratorSearch(PipeReader r, Span needle)
+{
+    for (auto it = r.begin(); it; ++it)
+    {
+        if (*it == needle[0] && it.Matches(needle))
+        {
+            return it - r.begin() + needle.Length();
+        }
+    }
+    return 0;
+}
+
+size_t IteratorFindAny(PipeReader r, Span set)
+{
+    for (auto it = r.begin(); it; ++it)
+    {
+        if (memchr(set.Pointer(), *it, set.Length()))
+        {
+            return it - r.begin() + 1;
+        }
+    }
+    return 0;
+}
+
+template<typename TLoop> uint32_t MeasureLoop(Span tail, TLoop loop, size_t expect)
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+    s.Add(&S::Fill, p, tail);
+    s.Run();
+
+    auto t0 = MONO_US;
+    PipeReader r(p);
+    for (size_t i = 0; i < Rounds; i++)
+    {
+        AssertEqual(loop(r), expect);
+    }
+    uint32_t us = MONO_US - t0;
+    r.Advance(r.Available());
+    return us;
+}
+
+TEST_CASE("01 Sequence")
+{
+    Span needle = "\r\n\r\n";
+    TestCase::ReportThroughput(Total, Measure("\r\n\r\n", [&](Scheduler& s, Pipe& p, uint32_t* us) { s.Add(&S::RequireUntil, p, needle, us); }), "RequireUntil \\r\\n\\r\\n");
+    TestCase::ReportThroughput(Total, MeasureLoop("\r\n\r\n", [&](PipeReader r) { return IteratorSearch(r, needle); }, Length + needle.Length()), "Iterator \\r\\n\\r\\n");
+}
+
+TEST_CASE("02 Byte Set")
+{
+    Span set = ";,\n";
+    TestCase::ReportThroughput(Total, Measure("\n", [&](Scheduler& s, Pipe& p, uint32_t* us) { s.Add(&S::FindAny, p, set, us); }), "FindAny ;,\\n");
+    TestCase::ReportThroughput(Total, MeasureLoop("\n", [&](PipeReader r) { return IteratorFindAny(r, set); }, Length + 1), "Iterator ;,\\n");
+}
+
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/pipes/Compression.cpp
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// produced by `lz4 -B4` from the lines generated by Telemetry(i, 20), with a content checksum
+const uint8_t Reference[] = {
+    0x04, 0x22, 0x4D, 0x18, 0x64, 0x40, 0xA7, 0xC3, 0x00, 0x00, 0x00, 0xF4,
+    0x15, 0x7B, 0x22, 0x74, 0x22, 0x3A, 0x31, 0x30, 0x30, 0x30, 0x2C, 0x22,
+    0x74, 0x65, 0x6D, 0x70, 0x22, 0x3A, 0x32, 0x30, 0x2E, 0x30, 0x2C, 0x22,
+    0x73, 0x74, 0x61, 0x74, 0x65, 0x22, 0x3A, 0x22, 0x6F, 0x6B, 0x22, 0x7D,
+    0x0A, 0x24, 0x00, 0x15, 0x31, 0x24, 0x00, 0x3F, 0x31, 0x2E, 0x31, 0x24,
+    0x00, 0x04, 0x15, 0x32, 0x24, 0x00, 0x3F, 0x32, 0x2E, 0x32, 0x24, 0x00,
+    0x04, 0x15, 0x33, 0x24, 0x00, 0x3F, 0x33, 0x2E, 0x33, 0x24, 0x00, 0x04,
+    0x15, 0x34, 0x24, 0x00, 0x3F, 0x34, 0x2E, 0x34, 0x24, 0x00, 0x04, 0x15,
+    0x35, 0x24, 0x00, 0x3F, 0x30, 0x2E, 0x35, 0x24, 0x00, 0x04, 0x15, 0x36,
+    0x24, 0x00, 0x3F, 0x31, 0x2E, 0x36, 0x24, 0x00, 0x04, 0x15, 0x37, 0x24,
+    0x00, 0x3F, 0x32, 0x2E, 0x37, 0x24, 0x00, 0x04, 0x15, 0x38, 0x24, 0x00,
+    0x3F, 0x33, 0x2E, 0x38, 0x24, 0x00, 0x04, 0x15, 0x39, 0x24, 0x00, 0x3F,
+    0x34, 0x2E, 0x39, 0x24, 0x00, 0x03, 0x1F, 0x31, 0x68, 0x01, 0x10, 0x1F,
+    0x31, 0x68, 0x01, 0x10, 0x1F, 0x31, 0x68, 0x01, 0x10, 0x1F, 0x31, 0x68,
+    0x01, 0x10, 0x1F, 0x31, 0x68, 0x01, 0x10, 0x1F, 0x31, 0x68, 0x01, 0x10,
+    0x1F, 0x31, 0x68, 0x01, 0x10, 0x1F, 0x31, 0x68, 0x01, 0x10, 0x1F, 0x31,
+    0x68, 0x01, 0x10, 0x1F, 0x31, 0x68, 0x01, 0x04, 0x50, 0x6F, 0x6B, 0x22,
+    0x7D, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x73, 0x6B, 0xC5, 0x02,
+};
+
+//! Formats a telemetry record, the one @p count records long sequence is what the reference frame contains
+size_t Telemetry(char* buf, size_t i, size_t count)
+{
+    if (count == 20)
+        return sprintf(buf, "{\"t\":%u,\"temp\":%u.%u,\"state\":\"ok\"}\n", unsigned(1000 + i), unsigned(20 + i % 5), unsigned(i % 10));
+    return sprintf(buf, "{\"t\":%u,\"temp\":%u.%u,\"hum\":%u,\"state\":\"%s\"}\n", unsigned(1000 + i), unsigned(20 + i % 7), unsigned(i * 7 % 10), unsigned(40 + i % 13), i % 50 ? "ok" : "alarm");
+}
+
+struct S
+{
+    //! Writes @p count records, pausing after every @p burst of them to let the encoder flush
+    static async(Source, PipeWriter w, size_t count, size_t burst)
+    async_def(
+        size_t i;
+        char line[80];
+    )
+    {
+        for (f.i = 0; f.i < count; f.i++)
+        {
+            await(w.Write, Span(f.line, Telemetry(f.line, f.i, count)));
+            if (burst && f.i % burst == burst - 1)
+            {
+                async_delay_ms(1);
+            }
+        }
+        // a stretch of data that does not compress
+        for (f.i = 0; f.i < sizeof(f.line); f.i++)
+        {
+            f.line[f.i] = (f.i * 2654435761u) >> 24;
+        }
+        await(w.Write, Span(f.line, sizeof(f.line)));
+        w.Close();
+    }
+    async_end
+
+    //! Verifies the output matches what Source produced
+    static async(Verify, PipeReader r, size_t count, size_t* total)
+    async_def(
+        size_t i, n;
+        char line[80];
+    )
+    {
+        for (f.i = 0; f.i < count; f.i++)
+        {
+            f.n = Telemetry(f.line, f.i, count);
+            await(r.Require, f.n);
+            Assert(r.Matches(Span(f.line, f.n)));
+            r.Advance(f.n);
+            *total += f.n;
+        }
+        for (f.i = 0; f.i < sizeof(f.line); f.i++)
+        {
+            f.line[f.i] = (f.i * 2654435761u) >> 24;
+        }
+        await(r.Require, sizeof(f.line));
+        Assert(r.Matches(Span(f.line, sizeof(f.line))));
+        r.Advance(sizeof(f.line));
+        AssertEqual(size_t(await(r.Require, 1)), 0u);
+        Assert(r.IsComplete());
+    }
+    async_end
+
+    static async(Feed, PipeWriter w, Span data, size_t times)
+    async_def(
+        size_t i;
+    )
+    {
+        for (f.i = 0; f.i < times; f.i++)
+        {
+            await(w.WriteStatic, data);
+        }
+        w.Close();
+    }
+    async_end
+
+    static async(Decode, Lz4Decoder* decoder, PipeReader r, PipeWriter w, bool* failed)
+    async_def(
+        AsyncCatchResult res;
+    )
+    {
+        f.res = await_catch(decoder->Run, r, w);
+        *failed = !f.res.Success();
+        if (*failed)
+        {
+            AssertException(f.res, io::FormatError, 0);
+        }
+    }
+    async_end
+};
+
+TEST_CASE("01 LZ4 Round Trip")
+{
+    for (size_t block: { 256, 4096, 65536 })
+    {
+        for (size_t burst: { 0, 7 })
+        {
+            Scheduler s;
+            Pipe plain, compressed, decompressed;
+            Lz4Encoder encoder(block);
+            Lz4Decoder decoder;
+            size_t total = 0;
+            bool failed;
+
+            s.Add(&S::Source, plain, 500, burst);
+            s.Add(encoder, &Lz4Encoder::Run, plain, compressed);
+            s.Add(&S::Decode, &decoder, compressed, decompressed, &failed);
+            s.Add(&S::Verify, decompressed, 500, &total);
+            s.Run();
+
+            Assert(!failed);
+            Assert(total > 20000);
+        }
+    }
+}
+
+TEST_CASE("02 LZ4 Reference Frame")
+{
+    Scheduler s;
+    Pipe compressed, decompressed;
+    Lz4Decoder decoder;
+    bool failed;
+    decompressed.ThrottleLevel(0);
+
+    // frames can be concatenated
+    s.Add(&S::Feed, compressed, Span(Reference, sizeof(Reference)), 2);
+    s.Add(&S::Decode, &decoder, compressed, decompressed, &failed);
+    s.Run();
+    Assert(!failed);
+
+    PipeReader r(decompressed);
+    char line[80];
+    for (size_t i = 0; i < 40; i++)
+    {
+        size_t n = Telemetry(line, i % 20, 20);
+        Assert(r.Matches(Span(line, n)));
+        r.Advance(n);
+    }
+    Assert(r.IsComplete());
+    AssertEqual(r.Available(), 0u);
+}
+
+TEST_CASE("03 LZSS Round Trip")
+{
+    for (unsigned bits: { 8, 10, 12 })
+    {
+        for (size_t burst: { 0, 3 })
+        {
+            Scheduler s;
+            Pipe plain, compressed, decompressed;
+            LzssEncoder encoder(bits);
+            LzssDecoder decoder;
+            size_t total = 0;
+
+            s.Add(&S::Source, plain, 500, burst);
+            s.Add(encoder, &LzssEncoder::Run, plain, compressed);
+            s.Add(decoder, &LzssDecoder::Run, compressed, decompressed);
+            s.Add(&S::Verify, decompressed, 500, &total);
+            s.Run();
+
+            Assert(total > 20000);
+        }
+    }
+}
+
+TEST_CASE("04 Malformed Input")
+{
+    Scheduler s;
+    Pipe compressed, decompressed;
+    Lz4Decoder decoder;
+    bool failed = false;
+
+    // a valid header followed by a block referencing data before its start
+    static const uint8_t frame[] = { 0x04, 0x22, 0x4D, 0x18, 0x60, 0x40, 0x82, 0x04, 0x00, 0x00, 0x00, 0x10, 0x41, 0x05, 0x00 };
+    s.Add(&S::Feed, compressed, Span(frame, sizeof(frame)), 1);
+    s.Add(&S::Decode, &decoder, compressed, decompressed, &failed);
+    s.Run();
+    Assert(failed);
+}
+
+}
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/pipes/Framer.cpp
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// payloads covering the corner cases of the encodings
+uint8_t zeros[3];
+uint8_t specials[] = { 0xC0, 0xDB, 0x00, 0xDB, 0xDC, 0xC0 };
+uint8_t large[600];
+
+const Span Payloads[] = { "A", Span(zeros), Span(specials), Span(large, 127), Span(large, 128), Span(large, 254), Span(large, 255), Span(large) };
+constexpr size_t Count = sizeof(Payloads) / sizeof(Payloads[0]);
+
+void Init()
+{
+    for (size_t i = 0; i < sizeof(large); i++)
+    {
+        // no zeros in the first 300 bytes, to exercise the full COBS blocks
+        large[i] = i < 300 ? i % 255 + 1 : i * 2654435761u >> 24;
+    }
+}
+
+//! Copies the spans of a frame to a buffer
+template<typename TSpans> size_t Collect(TSpans spans, uint8_t* buf)
+{
+    size_t n = 0;
+    for (Span s: spans)
+    {
+        AssertNotEqual(s.Length(), 0u);
+        memcpy(buf + n, s.Pointer(), s.Length());
+        n += s.Length();
+    }
+    return n;
+}
+
+template<typename TFramer> struct S
+{
+    //! Writes all payloads, @p dribble bytes at a time after encoding them into a separate pipe
+    static async(Writer, PipeWriter w, size_t dribble, TFramer* framer)
+    async_def(
+        Pipe encoded;
+        PipeReader r;
+        size_t i;
+        uint8_t buf[16];
+        size_t n;
+    )
+    {
+        f.encoded.ThrottleLevel(0);
+        f.r = f.encoded;
+        for (f.i = 0; f.i < Count; f.i++)
+        {
+            await(Write, dribble ? PipeWriter(f.encoded) : w, Payloads[f.i], framer);
+        }
+
+        if (dribble)
+        {
+            PipeWriter(f.encoded).Close();
+            while ((f.n = await(f.r.Read, Buffer(f.buf, dribble))))
+            {
+                await(w.Write, Span(f.buf, f.n));
+                async_yield();
+            }
+        }
+        w.Close();
+    }
+    async_end
+
+    static async(Write, PipeWriter w, Span payload, TFramer* framer);
+
+    //! Reads the payloads back, comparing them with the originals
+    static async(Reader, TFramer* framer)
+    async_def(
+        size_t i;
+        uint8_t buf[sizeof(large)];
+    )
+    {
+        for (f.i = 0; f.i < Count; f.i++)
+        {
+            Assert(await(framer->Next));
+            AssertEqual(framer->Length(), Payloads[f.i].Length());
+            AssertEqual(Collect(framer->Frame(), f.buf), Payloads[f.i].Length());
+            Assert(!memcmp(f.buf, Payloads[f.i].Pointer(), Payloads[f.i].Length()));
+        }
+        Assert(!await(framer->Next));
+    }
+    async_end
+
+    static void Run(TFramer& framer, Pipe& pipe, size_t dribble)
+    {
+        Scheduler s;
+        s.Add(&S::Reader, &framer);
+        s.Add(&S::Writer, pipe, dribble, &framer);
+        s.Run();
+        Assert(pipe.IsCompleted());
+    }
+};
+
+template<> async(S<VarintFramer>::Write, PipeWriter w, Span payload, VarintFramer* framer) { return async_forward(VarintFramer::Write, w, payload); }
+template<> async(S<CobsFramer>::Write, PipeWriter w, Span payload, CobsFramer* framer) { return async_forward(CobsFramer::Write, w, payload); }
+template<> async(S<SlipFramer>::Write, PipeWriter w, Span payload, SlipFramer* framer) { return async_forward(SlipFramer::Write, w, payload); }
+template<> async(S<HeaderFramer>::Write, PipeWriter w, Span payload, HeaderFramer* framer) { return async_forward(framer->Write, w, "\xAA\x00\x00\x55", payload); }
+
+//! Writes @p data to the pipe and closes it
+async(Feed, PipeWriter w, Span data)
+async_def()
+{
+    await(w.Write, data);
+    w.Close();
+}
+async_end
+
+TEST_CASE("01 Length Prefixed Frames")
+{
+    Init();
+    for (size_t dribble: { 0, 1, 7 })
+    {
+        Pipe p;
+        // the writer is throttled with several frames in the pipe, the largest one fits below the resume level
+        p.ThrottleLevel(1600, 800);
+        VarintFramer varint(p);
+        S<VarintFramer>::Run(varint, p, dribble);
+    }
+
+    for (size_t dribble: { 0, 1, 7 })
+    {
+        Pipe p;
+        p.ThrottleLevel(1600, 800);
+        HeaderFramer header(p, 4, 1, 2);
+        S<HeaderFramer>::Run(header, p, dribble);
+    }
+
+    // the length is encoded as expected
+    Scheduler s;
+    Pipe p;
+    s.Add(&VarintFramer::Write, p, Span(large, 300), Timeout::Infinite);
+    s.Run();
+    Assert(PipeReader(p).Matches("\xAC\x02"));
+}
+
+TEST_CASE("02 COBS Frames")
+{
+    Init();
+    for (size_t dribble: { 0, 1, 7 })
+    {
+        Pipe p;
+        p.ThrottleLevel(1600, 800);
+        CobsFramer cobs(p);
+        S<CobsFramer>::Run(cobs, p, dribble);
+    }
+
+    // reference encodings
+    Scheduler s;
+    Pipe p;
+    s.Add(&CobsFramer::Write, p, Span("\x11\x22\x00\x33", 4), Timeout::Infinite);
+    s.Add(&CobsFramer::Write, p, Span("\x00", 1), Timeout::Infinite);
+    s.Run();
+    Assert(PipeReader(p).Matches(Span("\x03\x11\x22\x02\x33\x00\x01\x01\x00", 9)));
+}
+
+TEST_CASE("03 SLIP Frames")
+{
+    Init();
+    for (size_t dribble: { 0, 1, 7 })
+    {
+        Pipe p;
+        p.ThrottleLevel(1600, 800);
+        SlipFramer slip(p);
+        S<SlipFramer>::Run(slip, p, dribble);
+    }
+
+    // reference encoding
+    Scheduler s;
+    Pipe p;
+    s.Add(&SlipFramer::Write, p, Span("\xC0\x01\xDB", 3), Timeout::Infinite);
+    s.Run();
+    Assert(PipeReader(p).Matches("\xC0\xDB\xDC\x01\xDB\xDD\xC0"));
+}
+
+struct Malformed
+{
+    template<typename TFramer> static async(Expect, TFramer* framer, Span expected)
+    async_def(
+        AsyncCatchResult res;
+        uint8_t buf[16];
+    )
+    {
+        // the first frame is malformed, the second one is read normally
+        f.res = await_catch(framer->Next);
+        AssertException(f.res, io::FormatError, 0);
+        Assert(await(framer->Next));
+        AssertEqual(Collect(framer->Frame(), f.buf), expected.Length());
+        Assert(!memcmp(f.buf, expected.Pointer(), expected.Length()));
+        Assert(!await(framer->Next));
+    }
+    async_end
+
+    template<typename TFramer> static async(Reject, TFramer* framer)
+    async_def(
+        AsyncCatchResult res;
+    )
+    {
+        f.res = await_catch(framer->Next);
+        AssertException(f.res, io::FormatError, 0);
+    }
+    async_end
+
+    static async(Oversized, PipeWriter w, HeaderFramer* framer)
+    async_def(
+        AsyncCatchResult res;
+    )
+    {
+        static char payload[300];
+        f.res = await_catch(framer->Write, w, "\xAA\x00", Span(payload, sizeof(payload)));
+        AssertException(f.res, io::FormatError, sizeof(payload));
+        // not even the header has been allocated
+        AssertEqual(w.Available(), 0u);
+    }
+    async_end
+};
+
+TEST_CASE("04 Malformed Frames")
+{
+    {
+        // a COBS block running past the delimiter
+        Scheduler s;
+        Pipe p;
+        CobsFramer cobs(p);
+        s.Add(&Malformed::Expect<CobsFramer>, &cobs, Span("OK"));
+        s.Add(&Feed, p, Span("\x05\x11\x00\x03OK\x00", 7));
+        s.Run();
+    }
+
+    {
+        // an invalid SLIP escape
+        Scheduler s;
+        Pipe p;
+        SlipFramer slip(p);
+        s.Add(&Malformed::Expect<SlipFramer>, &slip, Span("OK"));
+        s.Add(&Feed, p, "\xDBX\xC0OK\xC0");
+        s.Run();
+    }
+
+    {
+        // a frame that is too long is discarded up to its delimiter
+        Scheduler s;
+        Pipe p;
+        SlipFramer slip(p, 8);
+        s.Add(&Malformed::Expect<SlipFramer>, &slip, Span("OK"));
+        s.Add(&Feed, p, "0123456789ABCDEF\xC0OK\xC0");
+        s.Run();
+    }
+
+    {
+        // a length prefix above the limit, the stream cannot be resynchronized
+        Scheduler s;
+        Pipe p;
+        VarintFramer varint(p, 100);
+        s.Add(&Malformed::Reject<VarintFramer>, &varint);
+        s.Add(&Feed, p, "\xAC\x02");
+        s.Run();
+    }
+
+    {
+        // a payload too long for the length field is rejected before anything is written
+        Scheduler s;
+        Pipe p;
+        HeaderFramer header(p, 2, 1, 1);
+        s.Add(&Malformed::Oversized, p, &header);
+        s.Run();
+        AssertEqual(p.Unprocessed(), 0u);
+    }
+}
+
+}
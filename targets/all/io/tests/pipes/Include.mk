@@ -0,0 +1,10 @@
+#
+# Copyright (c) 2026 triaxis s.r.o.
+# Licensed under the MIT license. See LICENSE.txt file in the repository root
+# for full license information.
+#
+# io/tests/pipes/Include.mk
+#
+
+# make sure optional Pipe statistics are compiled and tested
+DEFINES += PIPE_STATS=1
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/pipes/MulticastPipe.cpp
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+constexpr size_t Count = 200;
+constexpr size_t Length = Count * 64;
+
+struct S
+{
+    static async(Writer, MulticastPipe* p)
+    async_def(
+        size_t i;
+        char line[64];
+    )
+    {
+        for (f.i = 0; f.i < Count; f.i++)
+        {
+            for (size_t j = 0; j < sizeof(f.line); j++)
+            {
+                f.line[j] = 'A' + (f.i + j) % 26;
+            }
+            await(p->Writer().Write, Span(f.line, sizeof(f.line)));
+        }
+        p->Close();
+    }
+    async_end
+
+    // reads everything, verifying the content and pausing every @p pace bytes
+    static async(Reader, MulticastReader* r, size_t pace, size_t* total)
+    async_def(
+        size_t n, next;
+    )
+    {
+        f.next = pace;
+        while ((f.n = await(r->Require, 1)))
+        {
+            auto span = r->GetSpan();
+            for (size_t i = 0; i < span.Length(); i++)
+            {
+                size_t pos = *total + i;
+                AssertEqual(span[i], char('A' + (pos / 64 + pos % 64) % 26));
+            }
+            *total += span.Length();
+            r->Advance(span.Length());
+            if (pace && *total >= f.next)
+            {
+                f.next += pace;
+                async_delay_ms(1);
+            }
+        }
+    }
+    async_end
+};
+
+TEST_CASE("01 Independent Readers")
+{
+    Scheduler s;
+    MulticastPipe p;
+    MulticastReader fast(p), slow(p), slower(p);
+    size_t totals[3] = {};
+    auto allocated = PipeAllocator::Stats().allocated;
+
+    s.Add(&S::Writer, &p);
+    s.Add(&S::Reader, &fast, 0, &totals[0]);
+    s.Add(&S::Reader, &slow, 1000, &totals[1]);
+    s.Add(&S::Reader, &slower, 3000, &totals[2]);
+    s.Run();
+
+    for (auto total: totals)
+    {
+        AssertEqual(total, Length);
+    }
+    Assert(fast.IsComplete() && slow.IsComplete() && slower.IsComplete());
+    AssertEqual(p.Retained(), 0u);
+    // the readers share the segments, they are not allocated for each of them
+    AssertLessOrEqual(PipeAllocator::Stats().allocated - allocated, Length / (64 - sizeof(PipeSegment)));
+}
+
+TEST_CASE("02 Lag Limits")
+{
+    Scheduler s;
+    MulticastPipe p;
+    p.ThrottleLevel(0);
+    MulticastReader fast(p), limited(p, 2048), dropping(p, 1024, MulticastLag::Drop);
+    size_t totals[2] = {};
+
+    struct L
+    {
+        // the reader holding the writer is never further behind than its limit allows
+        static async(Limited, MulticastReader* r, MulticastPipe* p, size_t* total)
+        async_def(
+            size_t n;
+        )
+        {
+            while ((f.n = await(r->Require, 1)))
+            {
+                AssertLessOrEqual(r->Available(), 2 * r->LagLimit());
+                *total += f.n;
+                r->Advance(f.n);
+                async_delay_ms(1);
+            }
+        }
+        async_end
+
+        // a reader that stops reading gets dropped instead of holding the others
+        static async(Stalled, MulticastReader* r)
+        async_def()
+        {
+            await(r->Require, 100);
+            async_delay_ms(50);
+            Assert(r->IsDropped());
+            Assert(r->IsComplete());
+            AssertEqual(await(r->Require, 1), 0);
+        }
+        async_end
+    };
+
+    s.Add(&S::Writer, &p);
+    s.Add(&S::Reader, &fast, 0, &totals[0]);
+    s.Add(&L::Limited, &limited, &p, &totals[1]);
+    s.Add(&L::Stalled, &dropping);
+    s.Run();
+
+    AssertEqual(totals[0], Length);
+    AssertEqual(totals[1], Length);
+    AssertEqual(p.Readers(), 2u);
+    AssertEqual(p.Retained(), 0u);
+}
+
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/pipes/PipeBudget.cpp
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// small hints make the default allocator provide segments from its smallest pool
+constexpr size_t Hint = 16;
+constexpr size_t Seg = 64 - sizeof(PipeSegment);
+
+TEST_CASE("01 Budget Limits")
+{
+    Scheduler s;
+    PipeBudget budget(Seg * 4);
+    PipeQuota a(budget);
+    PipeQuota guaranteed(budget, Seg);
+    PipeQuota limited(budget, 0, Seg);
+    AssertEqual(budget.Reserved(), Seg);
+
+    struct S
+    {
+        static async(Run, PipeBudget* budget, PipeQuota* a, PipeQuota* guaranteed, PipeQuota* limited)
+        async_def(
+            PipeSegment* segs[5];
+            size_t i;
+            AsyncCatchResult res;
+        )
+        {
+            // the minimum of the other quota cannot be used
+            for (f.i = 0; f.i < 3; f.i++)
+            {
+                f.segs[f.i] = (PipeSegment*)await(a->AllocateSegment, Hint, Timeout::Infinite);
+            }
+            AssertEqual(a->Used(), Seg * 3);
+            f.res = await_catch(a->AllocateSegment, Hint, Timeout::Milliseconds(5));
+            AssertException(f.res, io::TimeoutError, 0);
+
+            // but it is available to its owner
+            f.segs[3] = (PipeSegment*)await(guaranteed->AllocateSegment, Hint, Timeout::Infinite);
+            AssertEqual(budget->Used(), budget->Budget());
+            AssertEqual(budget->Reserved(), 0u);
+
+            // a quota cannot exceed its maximum even if the budget allows it
+            f.segs[0]->Release();
+            f.segs[1]->Release();
+            f.segs[4] = (PipeSegment*)await(limited->AllocateSegment, Hint, Timeout::Infinite);
+            f.res = await_catch(limited->AllocateSegment, Hint, Timeout::Milliseconds(5));
+            AssertException(f.res, io::TimeoutError, 0);
+            AssertEqual(budget->Used(), Seg * 3);
+
+            f.segs[2]->Release();
+            f.segs[3]->Release();
+            f.segs[4]->Release();
+        }
+        async_end
+    };
+
+    s.Add(&S::Run, &budget, &a, &guaranteed, &limited);
+    s.Run();
+
+    AssertEqual(budget.Used(), 0u);
+    AssertEqual(budget.Reserved(), Seg);
+}
+
+TEST_CASE("02 Fair Turns")
+{
+    Scheduler s;
+    PipeBudget budget(4096);
+    PipeQuota hog(budget), q1(budget), q2(budget);
+    int log[4];
+    size_t logged = 0;
+    PipeSegment* segs[4];
+
+    struct S
+    {
+        // allocates two segments, logging the order in which they were obtained
+        static async(Waiter, PipeQuota* q, int id, int* log, size_t* logged, PipeSegment** segs)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < 2; f.i++)
+            {
+                segs[*logged] = (PipeSegment*)await(q->AllocateSegment, Hint, Timeout::Infinite);
+                log[(*logged)++] = id;
+            }
+        }
+        async_end
+
+        static async(Hog, PipeQuota* q, PipeBudget* budget)
+        async_def(
+            PipeSegment* segs[512];
+            size_t n, i;
+        )
+        {
+            // take the entire budget
+            while (q->Used() < budget->Budget())
+            {
+                f.segs[f.n++] = (PipeSegment*)await(q->AllocateSegment, Hint, Timeout::Infinite);
+            }
+            async_delay_ms(1);
+
+            // each released segment goes to the next waiting quota in turn
+            for (f.i = 0; f.i < 4; f.i++)
+            {
+                f.segs[--f.n]->Release();
+                async_delay_ms(1);
+            }
+
+            while (f.n)
+            {
+                f.segs[--f.n]->Release();
+            }
+        }
+        async_end
+    };
+
+    s.Add(&S::Hog, &hog, &budget);
+    s.Add(&S::Waiter, &q1, 1, log, &logged, segs);
+    s.Add(&S::Waiter, &q2, 2, log, &logged, segs);
+    s.Run();
+
+    AssertEqual(logged, 4u);
+    AssertEqual(log[0], 1);
+    AssertEqual(log[1], 2);
+    AssertEqual(log[2], 1);
+    AssertEqual(log[3], 2);
+
+    for (auto seg: segs)
+    {
+        seg->Release();
+    }
+    AssertEqual(budget.Used(), 0u);
+}
+
+TEST_CASE("03 Budgeted Pipe")
+{
+    Scheduler s;
+    PipeBudget budget(4096);
+    PipeQuota quota(budget, 0, 2048);
+    Pipe p(quota);
+    p.ThrottleLevel(0);
+
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < 100; f.i++)
+            {
+                await(w.Write, Span("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF"));
+            }
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r, PipeQuota* quota)
+        async_def(
+            size_t n, total;
+        )
+        {
+            // the writer is held back by the quota until data is consumed
+            while ((f.n = await(r.Require, 1)))
+            {
+                // the allocator can round the last segment up
+                AssertLessOrEqual(quota->Used(), quota->Maximum() + MEMPOOL_MAX_SIZE);
+                f.total += f.n;
+                r.Advance(f.n);
+                async_delay_ms(1);
+            }
+            AssertEqual(f.total, 6400u);
+        }
+        async_end
+    };
+
+    s.Add(&S::Writer, p);
+    s.Add(&S::Reader, p, &quota);
+    s.Run();
+
+    Assert(p.IsCompleted());
+    // a completed pipe holds on to its last segment until it is reset or destroyed
+    p.Reset();
+    AssertEqual(budget.Used(), 0u);
+}
+
+}
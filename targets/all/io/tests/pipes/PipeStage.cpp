@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * io/tests/pipes/PipeStage.cpp
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+//! Converts the input to upper case, copying it
+class Upper : public PipeStage
+{
+    virtual async(Process, Pipe::SpanIterator input, PipeWriter output)
+    async_def(
+        Pipe::SpanIterator it;
+        size_t offset, length, total;
+        char buf[16];
+    )
+    {
+        for (f.it = input; f.it; ++f.it)
+        {
+            for (f.offset = 0; f.offset < (*f.it).Length(); f.offset += f.length)
+            {
+                f.length = std::min((*f.it).Length() - f.offset, sizeof(f.buf));
+                for (size_t i = 0; i < f.length; i++)
+                {
+                    char c = (*f.it)[f.offset + i];
+                    f.buf[i] = c >= 'a' && c <= 'z' ? c - 'a' + 'A' : c;
+                }
+                await(output.Write, Span(f.buf, f.length));
+            }
+            f.total += f.offset;
+        }
+        async_return(f.total);
+    }
+    async_end
+};
+
+//! Forwards complete lines, terminating the last one if needed
+class Lines : public PipeStage
+{
+    virtual async(Process, Pipe::SpanIterator input, PipeWriter output)
+    async_def(
+        size_t length;
+    )
+    {
+        size_t offset = 0;
+        for (auto span: input)
+        {
+            if (auto nl = (const char*)memrchr(span.Pointer(), '\n', span.Length()))
+            {
+                f.length = offset + (nl - span.Pointer()) + 1;
+            }
+            offset += span.Length();
+        }
+        await(Forward, output, 0, f.length);
+        async_return(f.length);
+    }
+    async_end
+
+    virtual async(Finish, PipeWriter output)
+    async_def()
+    {
+        if (Input().Available())
+        {
+            await(Forward, output, 0, Input().Available());
+            await(output.Write, "\n");
+        }
+    }
+    async_end
+};
+
+struct S
+{
+    static async(Source, PipeWriter w)
+    async_def(
+        size_t i;
+    )
+    {
+        for (f.i = 0; f.i < 50; f.i++)
+        {
+            await(w.Write, "first line, ");
+            async_yield();
+            await(w.Write, "still first\nsecond ");
+            async_yield();
+            await(w.Write, "line\nunterminated");
+            async_yield();
+            await(w.Write, " line\n");
+        }
+        await(w.Write, "tail");
+        w.Close();
+    }
+    async_end
+
+    static async(Verify, PipeReader r)
+    async_def(
+        size_t i;
+    )
+    {
+        for (f.i = 0; f.i < 50; f.i++)
+        {
+            await(r.Require, 54);
+            Assert(r.Matches("FIRST LINE, STILL FIRST\nSECOND LINE\nUNTERMINATED LINE\n"));
+            r.Advance(54);
+        }
+        AssertEqual(size_t(await(r.Require, 6)), 5u);
+        Assert(r.Matches("TAIL\n"));
+        r.Advance(5);
+        Assert(r.IsComplete());
+    }
+    async_end
+};
+
+TEST_CASE("01 Chained Stages")
+{
+    Scheduler s;
+    Pipe in, out;
+    Upper upper;
+    PipePassthrough passthrough;
+    Lines lines;
+    Pipeline pipeline;
+    pipeline.Add(upper).Add(passthrough).Add(lines);
+
+    s.Add(&S::Source, in);
+    s.Add(pipeline, &Pipeline::Run, in, out);
+    s.Add(&S::Verify, out);
+    s.Run();
+
+    AssertEqual(upper.Stats().in, 50u * 54 + 4);
+    AssertEqual(upper.Stats().out, upper.Stats().in);
+    AssertEqual(passthrough.Stats().in, upper.Stats().out);
+    AssertEqual(passthrough.Stats().out, passthrough.Stats().in);
+    AssertEqual(lines.Stats().in, 50u * 54);
+    AssertEqual(lines.Stats().out, 50u * 54 + 5);
+}
+
+}
@@ -249,4 +249,788 @@ TEST_CASE("04 Move")
     Assert(p2.IsCompleted());
 }
 
+TEST_CASE("05 External Write")
+{
+    Scheduler s;
+    Pipe p;
+
+    static char large[70000];
+    for (size_t i = 0; i < sizeof(large); i++)
+    {
+        large[i] = char(i * 7);
+    }
+
+    struct S
+    {
+        static void Released(size_t* released, Span data)
+        {
+            AssertEqual(data.Pointer(), (const void*)large);
+            *released += data.Length();
+        }
+
+        static async(Writer, PipeWriter w, size_t* released)
+        async_def()
+        {
+            await(w.Write, "HDR");
+            await(w.WriteExternal, Span(large, sizeof(large)), GetDelegate(&Released, released));
+            await(w.WriteStatic, "END");
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r, size_t* released)
+        async_def(
+            size_t read;
+            char buf[1000];
+        )
+        {
+            await(r.Require, 3);
+            Assert(r.Matches("HDR"));
+            r.Advance(3);
+
+            while (f.read < sizeof(large))
+            {
+                await(r.Require);
+                // the data must stay referenced until it is completely consumed
+                AssertEqual(*released, 0u);
+                Span chunk = r.Read(Buffer(f.buf).Left(std::min(r.Available(), sizeof(large) - f.read)));
+                Assert(chunk == Span(large + f.read, chunk.Length()));
+                f.read += chunk.Length();
+            }
+
+            AssertEqual(*released, sizeof(large));
+            await(r.Require, 3);
+            Assert(r.Matches("END"));
+            r.Advance(3);
+        }
+        async_end
+    };
+
+    size_t released = 0;
+    s.Add(&S::Reader, p, &released);
+    s.Add(&S::Writer, p, &released);
+    s.Run();
+
+    Assert(p.IsCompleted());
+    AssertEqual(released, sizeof(large));
+}
+
+TEST_CASE("06 External Write Failure")
+{
+    Scheduler s;
+    Pipe p;
+
+    struct S
+    {
+        static void Released(int* count, Span data)
+        {
+            ++*count;
+        }
+
+        static async(Writer, PipeWriter w, int* count)
+        async_def()
+        {
+            w.Close();
+            auto res = await_catch(w.WriteExternal, "DATA", GetDelegate(&Released, count));
+            AssertException(res, io::AbortError, 0);
+        }
+        async_end
+    };
+
+    int count = 0;
+    s.Add(&S::Writer, p, &count);
+    s.Run();
+
+    // the callback is invoked even if nothing was linked into the pipe
+    AssertEqual(count, 1);
+}
+
+TEST_CASE("07 Vectored IO")
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+
+    static char payload[600];
+    for (size_t i = 0; i < sizeof(payload); i++)
+    {
+        payload[i] = char('a' + i % 26);
+    }
+
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def(
+            Span parts[4];
+        )
+        {
+            f.parts[0] = "HDR:";
+            f.parts[1] = Span(payload, sizeof(payload));
+            f.parts[2] = Span();
+            f.parts[3] = "\n";
+            AssertEqual(size_t(await(w.WriteV, f.parts, 4)), sizeof(payload) + 5);
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r)
+        async_def()
+        {
+            await(r.Require, sizeof(payload) + 5);
+
+            Span spans[16];
+            size_t n = r.GetSpans(spans, 16);
+            size_t total = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                Assert(spans[i] == r.GetSpan(total));
+                total += spans[i].Length();
+            }
+            AssertEqual(total, sizeof(payload) + 5);
+            Assert(spans[0].Length() > 4);
+            Assert(r.Matches("HDR:abc"));
+            Assert(r.Matches("yzab\n", 4 + sizeof(payload) - 4));
+
+            // limited by count and length
+            AssertEqual(r.GetSpans(spans, 1), 1u);
+            AssertEqual(r.GetSpans(spans, 16, 3), 1u);
+            AssertEqual(spans[0].Length(), 3u);
+
+            r.Advance(total);
+        }
+        async_end
+    };
+
+    s.Add(&S::Reader, p);
+    s.Add(&S::Writer, p);
+    s.Run();
+
+    Assert(p.IsCompleted());
+}
+
+TEST_CASE("08 Sequence Search")
+{
+    Scheduler s;
+    Pipe p;
+
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def()
+        {
+            // each static write is a separate segment, so the matches straddle segment boundaries
+            await(w.WriteStatic, "GET / HTTP/1.1\r");
+            await(w.WriteStatic, "\nHost: a\r\n\r");
+            await(w.WriteStatic, "\n");
+            await(w.WriteStatic, "body;x");
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r)
+        async_def()
+        {
+            size_t n;
+            n = await(r.RequireUntil, Span("\r\n\r\n"));
+            AssertEqual(n, 27u);
+            Assert(r.Matches("Host: a\r\n\r\n", 16));
+            r.Advance(n);
+            n = await(r.FindAny, Span(",;"));
+            AssertEqual(n, 5u);
+            Assert(r.Matches("body;"));
+            r.Advance(n);
+            auto res = await_catch(r.RequireUntil, Span("\r\n"));
+            AssertException(res, io::AbortError, 1);
+            res = await_catch(r.FindAny, Span("\r\n"));
+            AssertException(res, io::AbortError, 1);
+            Assert(r.Matches("x"));
+            r.Advance(1);
+        }
+        async_end
+    };
+
+    s.Add(&S::Reader, p);
+    s.Add(&S::Writer, p);
+    s.Run();
+
+    Assert(p.IsCompleted());
+}
+
+TEST_CASE("09 Contiguous")
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+
+    struct S
+    {
+        static async(Run, Pipe* p)
+        async_def(
+            size_t i;
+        )
+        {
+            PipeWriter w(*p);
+            PipeReader r(*p);
+
+            await(w.WriteStatic, "HEAD");
+            await(w.WriteStatic, "ER:12");
+            await(w.WriteStatic, "34567890zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzz");
+            // the last segment is still being written
+            await(w.Write, "abc");
+
+            // within the first segment
+            AssertEqual(size_t(await(r.Contiguous, 3)), 4u);
+            AssertEqual(r.GetSpan(), Span("HEAD"));
+
+            // the second segment is merged entirely, the rest of the third one stays in place
+            AssertEqual(size_t(await(r.Contiguous, 12)), 12u);
+            AssertEqual(r.GetSpan(), Span("HEADER:12345"));
+            r.Advance(7);
+            AssertEqual(r.GetSpan(), Span("12345"));
+            r.Advance(5);
+            AssertEqual(r.GetSpan().Left(8), Span("67890zzz"));
+            AssertEqual(r.GetSpan().Length(), 103u);
+            r.Advance(101);
+
+            // the merged segment takes over the write segment
+            AssertEqual(size_t(await(r.Contiguous, 5)), 5u);
+            AssertEqual(r.GetSpan(), Span("zzabc"));
+            await(w.Write, "def");
+            AssertEqual(r.Available(), 8u);
+            Assert(r.Matches("zzabcdef"));
+            r.Advance(3);
+            AssertEqual(r.GetSpan(), Span("bc"));
+            r.Advance(2);
+            AssertEqual(r.GetSpan(), Span("def"));
+
+            // too large for the default allocator
+            for (f.i = 0; f.i < 40; f.i++)
+            {
+                await(w.WriteStatic, "0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF");
+            }
+            auto res = await_catch(r.Contiguous, 2000);
+            AssertException(res, io::AbortError, 1024);
+            Assert(r.Matches("def0123"));
+
+            // the stream ends before the requested count
+            r.Advance(3 + 40 * 64);
+            await(w.WriteStatic, "xy");
+            await(w.Write, "z");
+            w.Close();
+            AssertEqual(size_t(await(r.Contiguous, 10)), 3u);
+            AssertEqual(r.GetSpan(), Span("xyz"));
+            r.Advance(3);
+        }
+        async_end
+    };
+
+    s.Add(&S::Run, &p);
+    s.Run();
+
+    Assert(p.IsCompleted());
+}
+
+TEST_CASE("10 Segment Sizing")
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+
+    struct S
+    {
+        static async(Run, Pipe* p)
+        async_def(
+            size_t i, round;
+            PipeAllocatorStats before;
+        )
+        {
+            PipeWriter w(*p);
+            PipeReader r(*p);
+
+            // a reader keeping up with the writer keeps segments small
+            for (f.i = 0; f.i < 100; f.i++)
+            {
+                await(w.Write, Span("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF"));
+                AssertLessOrEqual(w.Available(), size_t(MEMPOOL_MAX_SIZE));
+                r.Advance(r.Available());
+            }
+
+            for (f.round = 0; f.round < 2; f.round++)
+            {
+                f.before = PipeAllocator::Stats();
+
+                // data piling up in the pipe grows the segments up to the maximum length
+                for (f.i = 0; f.i < 4000; f.i++)
+                {
+                    await(w.Write, Span("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF"));
+                }
+
+                Span spans[16];
+                size_t n = r.GetSpans(spans, 16);
+                AssertLessOrEqual(n, 10u);
+                AssertEqual(spans[n - 2].Length(), size_t(PIPE_SEGMENT_MAX));
+                // every span is a separate segment, only the first one may have been allocated before
+                AssertLessOrEqual(PipeAllocator::Stats().allocated - f.before.allocated, uint32_t(n));
+                AssertGreaterOrEqual(PipeAllocator::Stats().allocated - f.before.allocated, uint32_t(n - 1));
+                if (f.round)
+                {
+                    // the segments released by the previous round are reused
+                    AssertGreaterOrEqual(PipeAllocator::Stats().recycled - f.before.recycled, 2u);
+                }
+                r.Advance(r.Available());
+            }
+
+            // hints between the pool sizes and the smallest bucket are allocated as requested
+            f.i = w.Available();
+            await(w.Allocate, 512);
+            AssertEqual(w.Available() - f.i, 512u);
+
+            // unwritten space at the end of the last segment is wasted when the pipe is closed
+            f.before = PipeAllocator::Stats();
+            f.i = w.Available();
+            w.Close();
+            AssertEqual(PipeAllocator::Stats().wasted - f.before.wasted, uint32_t(f.i));
+        }
+        async_end
+    };
+
+    s.Add(&S::Run, &p);
+    s.Run();
+
+    Assert(p.IsCompleted());
+}
+
+TEST_CASE("11 Watermarks")
+{
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < 1000; f.i++)
+            {
+                await(w.Write, Span("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF"));
+            }
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r)
+        async_def()
+        {
+            while (await(r.Require, 64))
+            {
+                // writes are held at the high watermark, the last segment allocated below it can overshoot
+                AssertLessOrEqual(r.Available(), r.ThrottleLevel() * 2);
+                r.Advance(std::min(r.Available(), size_t(64)));
+                async_yield();
+            }
+        }
+        async_end
+
+        static uint32_t Run(size_t high, size_t low)
+        {
+            Scheduler s;
+            Pipe p;
+            PipeWriter(p).ThrottleLevel(high, low);
+            AssertEqual(PipeReader(p).ResumeLevel(), low);
+            s.Add(&Writer, p);
+            s.Add(&Reader, p);
+            s.Run();
+            Assert(p.IsCompleted());
+            return p.ThrottleCount();
+        }
+    };
+
+    // the writer is woken up less often when the reader has to drain the pipe first
+    auto single = S::Run(8192, 8192);
+    auto hysteresis = S::Run(8192, 1024);
+    AssertGreaterOrEqual(hysteresis, 1u);
+    AssertLessOrEqual(hysteresis * 2, single);
+
+    Pipe p;
+    p.ThrottleLevel(2000);
+    AssertEqual(p.ResumeLevel(), 1000u);
+}
+
+TEST_CASE("12 Notify Policy")
+{
+    struct S
+    {
+        static async(Writer, PipeWriter w, size_t count)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < count; f.i++)
+            {
+                await(w.Write, Span("x"));
+                async_yield();
+            }
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r, size_t* wakeups)
+        async_def()
+        {
+            while (await(r.Require, 1))
+            {
+                (*wakeups)++;
+                r.Advance(r.Available());
+            }
+        }
+        async_end
+
+        static size_t Run(PipeNotify policy, uint32_t threshold)
+        {
+            Scheduler s;
+            Pipe p;
+            size_t wakeups = 0;
+            PipeWriter(p).NotifyPolicy(policy, threshold);
+            s.Add(&Writer, p, size_t(200));
+            s.Add(&Reader, p, &wakeups);
+            s.Run();
+            Assert(p.IsCompleted());
+            return wakeups;
+        }
+
+        // writes a few bytes and waits without publishing them explicitly
+        static async(IdleWriter, Pipe* p)
+        async_def()
+        {
+            PipeWriter(*p).NotifyPolicy(PipeNotify::Bytes, 1000);
+            await(PipeWriter(*p).Write, Span("abc"));
+            async_delay_ms(5);
+            // the pending bytes are published when the scheduler goes idle
+            AssertEqual(p->Unprocessed(), 0u);
+            PipeWriter(*p).Close();
+        }
+        async_end
+
+        // the pending bytes are published together with a newly allocated segment
+        static async(AllocatingWriter, Pipe* p, bool* signal)
+        async_def()
+        {
+            PipeWriter(*p).NotifyPolicy(PipeNotify::Bytes, 1000);
+            await(PipeWriter(*p).Write, Span("abc"));
+            Assert(!*signal);
+            await(PipeWriter(*p).Allocate, 100);
+            Assert(*signal);
+            PipeWriter(*p).Close();
+        }
+        async_end
+
+        // writes a few bytes and keeps the scheduler busy without writing anything else
+        static async(BusyWriter, Pipe* p, mono_t* written)
+        async_def(
+            mono_t start;
+        )
+        {
+            PipeWriter(*p).NotifyPolicy(PipeNotify::Latency, MonoFromMilliseconds(5));
+            // the reader starts waiting for the data only after the segment is allocated
+            await(PipeWriter(*p).Allocate, 100);
+            async_yield();
+            await(PipeWriter(*p).Write, Span("abc"));
+            *written = f.start = MONO_CLOCKS;
+            // the scheduler never goes idle, only the deadline publishes the bytes
+            while (MONO_CLOCKS - f.start < MonoFromMilliseconds(50))
+            {
+                // the test platform advances the time only when sleeping, each step takes a tick instead
+                __testrunner_time++;
+                async_yield();
+            }
+            PipeWriter(*p).Close();
+        }
+        async_end
+
+        static async(TimedReader, PipeReader r, mono_t* notified)
+        async_def()
+        {
+            await(r.Require, 1);
+            *notified = MONO_CLOCKS;
+            r.Advance(r.Available());
+        }
+        async_end
+    };
+
+    auto immediate = S::Run(PipeNotify::Immediate, 0);
+    AssertGreaterOrEqual(immediate, 100u);
+    AssertLessOrEqual(S::Run(PipeNotify::Bytes, 16) * 4, immediate);
+    AssertLessOrEqual(S::Run(PipeNotify::Segment, 0) * 4, immediate);
+    AssertLessOrEqual(S::Run(PipeNotify::Latency, MONO_FREQUENCY) * 4, immediate);
+
+    Scheduler s;
+    Pipe p;
+    size_t wakeups = 0;
+    s.Add(&S::IdleWriter, &p);
+    s.Add(&S::Reader, p, &wakeups);
+    s.Run();
+    AssertEqual(wakeups, 1u);
+
+    Pipe p2;
+    bool signal = false;
+    p2.BindSignal(&signal);
+    s.Add(&S::AllocatingWriter, &p2, &signal);
+    s.Run();
+    Assert(p2.IsClosed());
+
+    // the deadline of the Latency policy is enforced even when the scheduler never goes idle
+    Pipe p3;
+    mono_t written = 0, notified = 0;
+    s.Add(&S::BusyWriter, &p3, &written);
+    s.Add(&S::TimedReader, p3, &notified);
+    s.Run();
+    AssertGreaterOrEqual(notified - written, MonoFromMilliseconds(5));
+    AssertLessOrEqual(notified - written, MonoFromMilliseconds(25));
+}
+
+TEST_CASE("13 Span Scanning")
+{
+    Scheduler s;
+    Pipe p;
+    p.ThrottleLevel(0);
+
+    static char data[4000];
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        // words and lines separated by whitespace runs of up to 40 bytes
+        data[i] = i % 97 < 40 ? " \t\r\n"[i % 97 / 10] : i % 53 ? 'a' + i % 26 : '\n';
+    }
+
+    struct S
+    {
+        // small writes, to spread the data over several segments
+        static async(Fill, PipeWriter w)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < sizeof(data); f.i += 50)
+            {
+                await(w.Write, Span(data + f.i, 50));
+            }
+        }
+        async_end
+
+        static bool IsSpace(uint8_t c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+    };
+
+    s.Add(&S::Fill, p);
+    s.Run();
+
+    PipeReader r(p);
+    AssertEqual(r.Available(), sizeof(data));
+    size_t spans = 0, total = 0;
+    AssertEqual(r.ForEachSpan(sizeof(data), [&](Span span) { spans++; total += span.Length(); }), sizeof(data));
+    AssertEqual(total, sizeof(data));
+    AssertGreaterThan(spans, 1u);
+
+    // the callback stops the iteration by not processing the whole span
+    AssertEqual(r.ForEachSpan(sizeof(data), [&](Span span) { return size_t(10); }), 10u);
+
+    size_t lines = 0;
+    for (char c: r)
+    {
+        lines += c == '\n';
+    }
+    AssertEqual(r.Enumerate(sizeof(data)).CountLines(), lines);
+
+    for (size_t offset = 0; offset < sizeof(data); offset += 7)
+    {
+        size_t end = offset;
+        while (end < sizeof(data) && S::IsSpace(data[end]))
+        {
+            end++;
+        }
+        auto it = r.Enumerate(sizeof(data)) + offset;
+        AssertEqual(it.SkipWhitespace(), end - offset);
+        AssertEqual(size_t(it - r.begin()), end);
+        if (end < sizeof(data))
+        {
+            AssertEqual(*it, data[end]);
+        }
+
+        it = r.Enumerate(sizeof(data)) + offset;
+        size_t word = std::find_if(data + offset, data + sizeof(data), S::IsSpace) - data;
+        AssertEqual(it.Scan([](uint8_t c) { return !S::IsSpace(c); }), word - offset);
+    }
+
+    static char copy[sizeof(data)];
+    memcpy(copy, data, sizeof(data));
+    AssertEqual(r.Enumerate(sizeof(data)).Mismatch(Span(copy, 3000)), 3000u);
+    AssertEqual(r.Enumerate(100).Mismatch(Span(copy, sizeof(copy))), 100u);
+    for (size_t pos: { 0, 49, 50, 2999, 3999 })
+    {
+        copy[pos] ^= 1;
+        auto it = r.Enumerate(sizeof(data));
+        AssertEqual(it.Mismatch(Span(copy, sizeof(copy))), pos);
+        AssertEqual(*it, data[pos]);
+        copy[pos] ^= 1;
+    }
+
+    r.Advance(r.Available());
+}
+
+TEST_CASE("14 Formatted Writes")
+{
+    static char text[5000];
+    for (size_t i = 0; i < sizeof(text) - 1; i++)
+    {
+        text[i] = 'a' + i % 26;
+    }
+
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def()
+        {
+            // short output into a fresh segment, then long output spanning several segments
+            await(w.WriteF, "<%d>", 123);
+            await(w.WriteF, "[%s|%d]", text, 456);
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r, char* buf, size_t* length)
+        async_def()
+        {
+            while (await(r.Require, 1))
+            {
+                *length += r.Read(Buffer(buf + *length, r.Available())).Length();
+            }
+        }
+        async_end
+
+        static void Run(size_t throttle)
+        {
+            static char buf[sizeof(text) + 32];
+            size_t length = 0;
+            Scheduler s;
+            Pipe p;
+            p.ThrottleLevel(throttle);
+            s.Add(&Writer, p);
+            s.Add(&Reader, p, buf, &length);
+            s.Run();
+            Assert(p.IsCompleted());
+
+            AssertEqual(length, sizeof(text) - 1 + 11);
+            Assert(!memcmp(buf, "<123>[", 6));
+            Assert(!memcmp(buf + 6, text, sizeof(text) - 1));
+            Assert(!memcmp(buf + 6 + sizeof(text) - 1, "|456]", 5));
+        }
+    };
+
+    // unthrottled, the rest of the output is reserved at once
+    S::Run(0);
+    // throttled below the output length, the output is published in parts
+    S::Run(1024);
+}
+
+#if PIPE_STATS
+TEST_CASE("15 Statistics")
+{
+    struct S
+    {
+        // the writer outpaces the reader at first and then waits before the rest
+        static async(Writer, PipeWriter w)
+        async_def(
+            size_t i;
+        )
+        {
+            for (f.i = 0; f.i < 30; f.i++)
+            {
+                await(w.Write, Span("0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123456789ABCDEF0123"));
+                if (f.i == 20)
+                {
+                    async_delay_ms(2);
+                }
+            }
+            w.Close();
+        }
+        async_end
+
+        static async(Reader, PipeReader r)
+        async_def()
+        {
+            async_delay_ms(2);
+            while (await(r.Require, 1))
+            {
+                r.Advance(r.Available());
+            }
+        }
+        async_end
+
+        // the second segment is never granted by the quota
+        static async(Starved, PipeWriter w)
+        async_def(
+            AsyncCatchResult res;
+        )
+        {
+            await(w.Allocate, 1024);
+            f.res = await_catch(w.Allocate, 1024, Timeout::Milliseconds(10));
+            AssertException(f.res, io::TimeoutError, 0);
+        }
+        async_end
+    };
+
+    Scheduler s;
+    Pipe p, other;
+    p.ThrottleLevel(1000, 500);
+    p.Register("test");
+    other.Register("other");
+
+    s.Add(&S::Writer, p);
+    s.Add(&S::Reader, p);
+    s.Run();
+    Assert(p.IsCompleted());
+
+    auto st = p.Stats();
+    AssertEqualString(st.name, "test");
+    AssertEqual(st.written, 3000u);
+    AssertEqual(st.read, 3000u);
+    AssertGreaterOrEqual(st.segments, 1u);
+    AssertGreaterThan(st.peak, 0u);
+    // a segment is allocated while below the throttle level, and is never larger than it
+    AssertLessThan(st.peak, 2000u);
+    AssertGreaterThan(st.changes, 30u);
+    AssertGreaterOrEqual(st.throttleCount, 1u);
+    AssertGreaterOrEqual(st.allocateTime, st.throttleTime);
+    AssertGreaterOrEqual(st.requireTime, mono_t(MONO_FREQUENCY / 1000));
+
+    // the registered pipes are enumerable, until they are destroyed
+    {
+        Pipe temp;
+        temp.Register("temp");
+        AssertEqual(Pipe::First(), &temp);
+        AssertEqual(temp.Next(), &other);
+        AssertEqual(other.Next(), &p);
+    }
+    AssertEqual(Pipe::First(), &other);
+
+    char json[512];
+    format_write_info wi = { json, json + sizeof(json) - 1 };
+    Pipe::DumpJson(format_output_mem, &wi);
+    *wi.p = 0;
+    Assert(strstr(json, "[{\"name\":\"other\",\"written\":0,"));
+    Assert(strstr(json, "{\"name\":\"test\",\"written\":3000,\"read\":3000,"));
+
+    other.Unregister();
+    AssertEqual(Pipe::First(), &p);
+
+    {
+        // waiting for an allocator that fails in the end counts as well
+        PipeBudget budget(1024);
+        PipeQuota quota(budget, 0, 1024);
+        Pipe starved(quota);
+        starved.ThrottleLevel(0);
+        s.Add(&S::Starved, starved);
+        s.Run();
+        AssertGreaterOrEqual(starved.Stats().allocateTime, mono_t(MONO_FREQUENCY / 100));
+    }
+}
+#endif
+
 }
@@ -312,9 +312,9 @@ mono_t Scheduler::Run()
                         auto align = (intptr_t)task->wait.ptr & (sizeof(uintptr_t) - 1);
                         task->wait.ptr = (uintptr_t*)((intptr_t)task->wait.ptr & ~(sizeof(uintptr_t) - 1));
 #if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
-                        task->wait.mask = 0xFF << (align << 3);
+                        task->wait.mask = uintptr_t(0xFF) << (align << 3);
 #else
-                        task->wait.mask = 0xFF << ((sizeof(uintptr_t) - 1 -align) << 3);
+                        task->wait.mask = uintptr_t(0xFF) << ((sizeof(uintptr_t) - 1 -align) << 3);
 #endif
                     }
                     task->wait.invert = type && AsyncResult::_WaitInvertedMask;
@@ -13,6 +13,8 @@
 #include <kernel/async.h>
 #include <kernel/Scheduler.h>
 
+#include <base/Arena.h>
+
 namespace   // prevent collisions
 {
 
@@ -110,4 +112,46 @@ TEST_CASE("02 Masked waits")
     s.Run();
 }
 
+TEST_CASE("03 Arena in frame")
+{
+    struct
+    {
+        async(Test, int items) async_def(
+            Arena arena;
+            int* first;
+            int i;
+        )
+        {
+            f.first = f.arena.New<int>(-1);
+            for (f.i = 0; f.i < items; f.i++)
+            {
+                // allocations survive across yields
+                last = f.arena.New<int>(f.i);
+                async_yield();
+                AssertEqual(*last, f.i);
+            }
+            AssertEqual(*f.first, -1);
+            async_return(f.arena.Mark().chunk != NULL);
+        }
+        async_end
+
+        int* last = NULL;
+        AsyncFrame* p = NULL;
+        async_res_t Step() { return Test(&p, ARENA_CHUNK_SIZE / sizeof(int) * 2); }
+    } t;
+
+    async_res_t res;
+    int steps = 0;
+    while (_ASYNC_RES_TYPE(res = t.Step()) == AsyncResult::SleepTicks)
+    {
+        steps++;
+    }
+
+    // the arena spanned multiple chunks and was released together with the frame
+    AssertEqual(steps, int(ARENA_CHUNK_SIZE / sizeof(int) * 2));
+    AssertEqual(_ASYNC_RES_TYPE(res), AsyncResult::Complete);
+    AssertEqual(_ASYNC_RES_VALUE(res), 1);
+    AssertEqual(t.p, (AsyncFrame*)NULL);
+}
+
 }
@@ -55,6 +55,30 @@ bool TestCase::RunAll(int argc, char** argv)
     return failed != 0;
 }
 
+void TestCase::ReportMetric(uint64_t thousandths, const char* unit, const char* name, ...)
+{
+    va_list va;
+    va_start(va, name);
+    ReportMetricV(thousandths, unit, name, va);
+    va_end(va);
+}
+
+void TestCase::ReportThroughput(uint64_t bytes, uint32_t us, const char* name, ...)
+{
+    va_list va;
+    va_start(va, name);
+    // bytes per microsecond are MB/s
+    ReportMetricV(bytes * 1000 / std::max(us, 1u), "MB/s", name, va);
+    va_end(va);
+}
+
+void TestCase::ReportMetricV(uint64_t thousandths, const char* unit, const char* name, va_list va)
+{
+    printf("| | ");
+    vprintf(name, va);
+    printf(" [%s] | %u.%03u | |\n", unit, unsigned(thousandths / 1000), unsigned(thousandths % 1000));
+}
+
 bool TestCase::Match(int numFilters, char** filters)
 {
     if (!numFilters)
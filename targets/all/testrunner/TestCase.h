@@ -24,6 +24,13 @@ public:
 
     static TestCase* Active() { return s_cur; }
 
+    //! Adds a row with a measured value to the result table, @p name is formatted like printf
+    //! The row is named "<name> [<unit>]" and shows the value, given in thousandths of the unit,
+    //! with three decimal places in the duration column, so that successive runs can be compared
+    static void ReportMetric(uint64_t thousandths, const char* unit, const char* name, ...);
+    //! Adds a row with the throughput in MB/s of processing @p bytes in @p us microseconds
+    static void ReportThroughput(uint64_t bytes, uint32_t us, const char* name, ...);
+
 protected:
     TestCase();
     virtual void Run() = 0;
@@ -66,6 +73,7 @@ private:
     bool Match(int numFilters, char** filters);
     bool Execute();
     void PrintResult(int errorLine = 0, std::function<void(void)> errorReason = {});
+    static void ReportMetricV(uint64_t thousandths, const char* unit, const char* name, va_list va);
 
     static TestCase* s_first;
     static TestCase* s_last;
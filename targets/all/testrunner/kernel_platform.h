@@ -24,7 +24,12 @@ extern mono_t __testrunner_time;
 #define PLATFORM_DISABLE_INTERRUPTS()
 #define PLATFORM_ENABLE_INTERRUPTS()
 #undef PLATFORM_SLEEP
+#if Thost
+// real file descriptors are still serviced while the time jumps forward
+#define PLATFORM_SLEEP(since, duration) ({ __platform_poll_fds(0); __testrunner_time = since + duration; })
+#else
 #define PLATFORM_SLEEP(since, duration) ({ __testrunner_time = since + duration; })
+#endif
 
 #ifndef PLATFORM_CRITICAL_SECTION
 #define PLATFORM_CRITICAL_SECTION()
@@ -15,6 +15,11 @@
 #include <chrono>
 #include <thread>
 
+#ifdef __linux__
+#include <errno.h>
+#include <sys/epoll.h>
+#endif
+
 static std::chrono::steady_clock::time_point __steady_clock_zero()
 {
     static auto __zero = std::chrono::steady_clock::now();
@@ -28,7 +33,112 @@ uint64_t __platform_mono_us()
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - __steady_clock_zero()).count();
 }
 
+#ifdef __linux__
+
+static int __epoll_fd = -1;
+static __platform_fd_watch* __watches;
+
+// recalculates the events of interest for the descriptor from all its watches
+static bool __platform_update_fd(int fd, int op)
+{
+    epoll_event ev = {};
+    ev.data.fd = fd;
+    for (auto w = __watches; w; w = w->next)
+    {
+        if (w->fd == fd)
+        {
+            ev.events |= w->events;
+        }
+    }
+
+    if (!ev.events)
+    {
+        return !epoll_ctl(__epoll_fd, EPOLL_CTL_DEL, fd, &ev);
+    }
+
+    // edge-triggered, the owners retry I/O until it would block before waiting for the next event
+    ev.events |= EPOLLET;
+    return !epoll_ctl(__epoll_fd, op, fd, &ev) || (op == EPOLL_CTL_ADD && errno == EEXIST && !epoll_ctl(__epoll_fd, EPOLL_CTL_MOD, fd, &ev));
+}
+
+bool __platform_watch_fd(__platform_fd_watch* watch)
+{
+    if (__epoll_fd < 0 && (__epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0)
+    {
+        return false;
+    }
+
+    watch->next = __watches;
+    __watches = watch;
+    if (!__platform_update_fd(watch->fd, EPOLL_CTL_ADD))
+    {
+        __watches = watch->next;
+        return false;
+    }
+    return true;
+}
+
+void __platform_unwatch_fd(__platform_fd_watch* watch)
+{
+    for (auto pw = &__watches; *pw; pw = &(*pw)->next)
+    {
+        if (*pw == watch)
+        {
+            *pw = watch->next;
+            __platform_update_fd(watch->fd, EPOLL_CTL_MOD);
+            break;
+        }
+    }
+}
+
+bool __platform_poll_fds(int timeoutMs)
+{
+    if (!__watches)
+    {
+        return false;
+    }
+
+    epoll_event events[16];
+    int n = epoll_wait(__epoll_fd, events, countof(events), timeoutMs);
+    for (int i = 0; i < n; i++)
+    {
+        for (auto w = __watches; w; w = w->next)
+        {
+            if (w->fd == events[i].data.fd)
+            {
+                w->ready |= events[i].events & (w->events | EPOLLERR | EPOLLHUP);
+                if (w->callback)
+                {
+                    w->callback(w);
+                }
+            }
+        }
+    }
+    return n > 0;
+}
+
+void __platform_sleep(uint64_t until)
+{
+    if (__watches)
+    {
+        // wake up as soon as any of the watched descriptors becomes ready
+        auto now = __platform_mono_us();
+        __platform_poll_fds(until > now ? int(std::min<uint64_t>((until - now + 999) / 1000, INT32_MAX)) : 0);
+        return;
+    }
+
+    std::this_thread::sleep_until(__steady_clock_zero() + std::chrono::microseconds(until));
+}
+
+#else
+
+bool __platform_watch_fd(__platform_fd_watch* watch) { return false; }
+void __platform_unwatch_fd(__platform_fd_watch* watch) {}
+bool __platform_poll_fds(int timeoutMs) { return false; }
+
 void __platform_sleep(uint64_t until)
 {
     std::this_thread::sleep_until(__steady_clock_zero() + std::chrono::microseconds(until));
 }
+
+#endif
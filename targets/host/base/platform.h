@@ -15,6 +15,23 @@
 extern void __platform_sleep(uint64_t until);
 extern uint64_t __platform_mono_us();
 
+//! File descriptor monitored while the platform sleeps (Linux only)
+struct __platform_fd_watch
+{
+    __platform_fd_watch* next;
+    int fd;
+    uint32_t events;    //!< EPOLL* events of interest
+    uint32_t ready;     //!< Events are ORed in when they occur, the owner clears them before retrying I/O
+    void (*callback)(__platform_fd_watch* watch);   //!< Optional handler invoked from the sleep path after events are ORed in
+};
+
+//! Starts monitoring the file descriptor, sleep is then interrupted when any of the watched descriptors becomes ready
+extern bool __platform_watch_fd(__platform_fd_watch* watch);
+//! Stops monitoring the file descriptor
+extern void __platform_unwatch_fd(__platform_fd_watch* watch);
+//! Collects pending events on watched descriptors, waiting up to the specified number of milliseconds
+extern bool __platform_poll_fds(int timeoutMs);
+
 #define PLATFORM_DBG_CHAR(channel, ch) putchar(ch)
 #define PLATFORM_DBG_ACTIVE(channel) ((channel) == 0)
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/FdReceiver.cpp
+ */
+
+#include "FdReceiver.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+namespace io
+{
+
+FdReceiver::FdReceiver(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    watch.fd = fd;
+#ifdef __linux__
+    watch.events = EPOLLIN | EPOLLRDHUP;
+#else
+    // descriptors cannot be watched, readiness is polled in Wait
+    watch.events = 0;
+#endif
+    watch.ready = 0;
+    watch.callback = NULL;
+    __platform_watch_fd(&watch);
+}
+
+FdReceiver::~FdReceiver()
+{
+    __platform_unwatch_fd(&watch);
+}
+
+size_t FdReceiver::TryAddBuffer(size_t offset, Buffer buffer)
+{
+    if (eof || count == MaxBuffers)
+    {
+        return 0;
+    }
+
+    buffers[(head + count++) % MaxBuffers] = buffer;
+    return buffer.Length();
+}
+
+const char* FdReceiver::GetWritePointer(Buffer buffer)
+{
+    Fill();
+    return Current();
+}
+
+async_once(FdReceiver::Wait, const char* current, Timeout timeout)
+{
+    Fill();
+    if (eof || Current() != current)
+    {
+        async_once_return(true);
+    }
+
+#ifdef __linux__
+    return async_forward(WaitMaskNot, watch.ready, uint32_t(EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR), 0u, timeout);
+#else
+    // nothing will wake us up, retry after a short while
+    return async_forward(WaitMaskNot, watch.ready, ~0u, 0u, Timeout::Milliseconds(1));
+#endif
+}
+
+async_once(FdReceiver::Close)
+{
+    count = 0;
+    filled = 0;
+    async_once_return(0);
+}
+
+void FdReceiver::Fill()
+{
+    while (count && !eof)
+    {
+        iovec iov[MaxBuffers];
+        for (unsigned i = 0; i < count; i++)
+        {
+            auto& buf = buffers[(head + i) % MaxBuffers];
+            iov[i].iov_base = buf.Pointer();
+            iov[i].iov_len = buf.Length();
+        }
+        iov[0].iov_base = (char*)iov[0].iov_base + filled;
+        iov[0].iov_len -= filled;
+
+        // clear readiness before trying, the edge-triggered watch reports only new data after EAGAIN
+        watch.ready = 0;
+        ssize_t res = readv(watch.fd, iov, count);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+            {
+                error = errno;
+                eof = true;
+            }
+            return;
+        }
+
+        if (res == 0)
+        {
+            eof = true;
+            return;
+        }
+
+        // consume the filled buffers
+        size_t n = res;
+        while (n)
+        {
+            size_t remaining = buffers[head].Length() - filled;
+            if (n < remaining)
+            {
+                filled += n;
+                break;
+            }
+            n -= remaining;
+            filled = 0;
+            head = (head + 1) % MaxBuffers;
+            count--;
+        }
+    }
+}
+
+}
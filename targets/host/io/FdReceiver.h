@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/FdReceiver.h
+ *
+ * Receiver reading from a non-blocking file descriptor directly into pipe
+ * buffers, woken by the platform sleep when the descriptor becomes readable
+ * (on Linux, the descriptor is polled elsewhere)
+ */
+
+#pragma once
+
+#include <io/Receiver.h>
+
+namespace io
+{
+
+class FdReceiver : public Receiver
+{
+public:
+    //! Switches the descriptor to non-blocking mode and starts watching it, the descriptor is not closed by the receiver
+    FdReceiver(int fd);
+    ~FdReceiver();
+
+    int Fd() const { return watch.fd; }
+    //! Gets the errno of the failure that ended the stream, zero after a regular end of file
+    int Error() const { return error; }
+
+protected:
+    size_t TryAddBuffer(size_t offset, Buffer buffer) override;
+    const char* GetWritePointer(Buffer buffer) override;
+    async_once(Wait, const char* current, Timeout timeout) override;
+    async_once(Close) override;
+    bool IsEndOfStream() override { return eof; }
+
+private:
+    enum { MaxBuffers = 8 };
+
+    __platform_fd_watch watch;
+    Buffer buffers[MaxBuffers];     //!< Queue of buffers added by the pipe, waiting to be filled
+    uint8_t head = 0, count = 0;
+    bool eof = false;
+    int error = 0;
+    size_t filled = 0;              //!< Number of bytes already filled in the head buffer
+
+    const char* Current() const { return count ? buffers[head].Pointer() + filled : NULL; }
+    void Fill();
+};
+
+}
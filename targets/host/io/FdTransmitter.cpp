@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/FdTransmitter.cpp
+ */
+
+#include "FdTransmitter.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+namespace io
+{
+
+FdTransmitter::FdTransmitter(int fd)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    watch.fd = fd;
+#ifdef __linux__
+    watch.events = EPOLLOUT;
+#else
+    // descriptors cannot be watched, readiness is polled in Wait
+    watch.events = 0;
+#endif
+    watch.ready = 0;
+    watch.callback = NULL;
+    __platform_watch_fd(&watch);
+}
+
+FdTransmitter::~FdTransmitter()
+{
+    __platform_unwatch_fd(&watch);
+}
+
+size_t FdTransmitter::TryAddBlock(Span block)
+{
+    Flush();
+    if (count == MaxBlocks)
+    {
+        return 0;
+    }
+
+    blocks[(head + count++) % MaxBlocks] = block;
+    Flush();
+    return block.Length();
+}
+
+const char* FdTransmitter::GetReadPointer()
+{
+    Flush();
+    return Current();
+}
+
+async_once(FdTransmitter::Wait, const char* current, Timeout timeout)
+{
+    Flush();
+    if (Current() != current)
+    {
+        async_once_return(true);
+    }
+
+#ifdef __linux__
+    return async_forward(WaitMaskNot, watch.ready, uint32_t(EPOLLOUT | EPOLLHUP | EPOLLERR), 0u, timeout);
+#else
+    // nothing will wake us up, retry after a short while
+    return async_forward(WaitMaskNot, watch.ready, ~0u, 0u, Timeout::Milliseconds(1));
+#endif
+}
+
+void FdTransmitter::Flush()
+{
+    while (count)
+    {
+        iovec iov[MaxBlocks];
+        for (unsigned i = 0; i < count; i++)
+        {
+            auto& block = blocks[(head + i) % MaxBlocks];
+            iov[i].iov_base = (void*)block.Pointer();
+            iov[i].iov_len = block.Length();
+        }
+        iov[0].iov_base = (char*)iov[0].iov_base + sent;
+        iov[0].iov_len -= sent;
+
+        // clear readiness before trying, the edge-triggered watch reports only new space after EAGAIN
+        watch.ready = 0;
+        ssize_t res = error ? -1 : writev(watch.fd, iov, count);
+        if (res < 0)
+        {
+            if (!error)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return;
+                }
+                error = errno;
+            }
+
+            // the descriptor is broken, discard everything so the pipe does not stall
+            last = blocks[(head + count - 1) % MaxBlocks].end();
+            count = 0;
+            sent = 0;
+            return;
+        }
+
+        // consume the sent blocks
+        size_t n = res;
+        while (n)
+        {
+            size_t remaining = blocks[head].Length() - sent;
+            if (n < remaining)
+            {
+                sent += n;
+                break;
+            }
+            n -= remaining;
+            last = blocks[head].end();
+            sent = 0;
+            head = (head + 1) % MaxBlocks;
+            count--;
+        }
+    }
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/FdTransmitter.h
+ *
+ * Transmitter writing pipe segments to a non-blocking file descriptor,
+ * woken by the platform sleep when the descriptor becomes writable
+ * (on Linux, the descriptor is polled elsewhere)
+ */
+
+#pragma once
+
+#include <io/Transmitter.h>
+
+namespace io
+{
+
+class FdTransmitter : public Transmitter
+{
+public:
+    //! Switches the descriptor to non-blocking mode and starts watching it, the descriptor is not closed by the transmitter
+    FdTransmitter(int fd);
+    ~FdTransmitter();
+
+    int Fd() const { return watch.fd; }
+    //! Gets the errno of the write failure, data is discarded after a failure
+    int Error() const { return error; }
+
+protected:
+    size_t TryAddBlock(Span block) override;
+    const char* GetReadPointer() override;
+    async_once(Wait, const char* current, Timeout timeout) override;
+
+private:
+    enum { MaxBlocks = 8 };
+
+    __platform_fd_watch watch;
+    Span blocks[MaxBlocks];         //!< Queue of blocks added from the pipe, waiting to be written
+    uint8_t head = 0, count = 0;
+    int error = 0;
+    size_t sent = 0;                //!< Number of bytes already sent from the head block
+    const char* last = NULL;        //!< End of the last block sent completely
+
+    const char* Current() const { return count ? blocks[head].Pointer() + sent : last; }
+    void Flush();
+};
+
+}
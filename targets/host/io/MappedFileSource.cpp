@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/MappedFileSource.cpp
+ */
+
+#include "MappedFileSource.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace io
+{
+
+static const size_t s_pageSize = sysconf(_SC_PAGESIZE);
+
+MappedFileSource::MappedFileSource(int fd, size_t window)
+    : fd(fd), window(std::max(window & ~(s_pageSize - 1), s_pageSize))
+{
+    struct stat st;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+    {
+        size = st.st_size;
+    }
+}
+
+async(MappedFileSource::WriteTo, PipeWriter pipe, uint64_t offset, uint64_t length, Timeout timeout)
+async_def(
+    Timeout timeout;
+    uint64_t start, pos, end;
+    Span data;
+)
+{
+    if (size < 0)
+    {
+        async_throw(IOError, -EBADF);
+    }
+
+    f.timeout = timeout.MakeAbsolute();
+    f.start = f.pos = std::min(offset, uint64_t(size));
+    f.end = f.pos + std::min(length, uint64_t(size) - f.pos);
+
+    while (f.pos < f.end)
+    {
+        // mappings must start at a page boundary, only the first window can start in the middle of one
+        uint64_t base = f.pos & ~uint64_t(s_pageSize - 1);
+        size_t len = std::min(f.end - base, uint64_t(window));
+        auto map = (const char*)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, base);
+        if (map == MAP_FAILED)
+        {
+            async_throw(IOError, -errno);
+        }
+
+        // the reader is expected to go through the pages in order, start reading them ahead right away
+        madvise((void*)map, len, MADV_SEQUENTIAL);
+        madvise((void*)map, len, MADV_WILLNEED);
+
+        f.data = Span(map + (f.pos - base), base + len - f.pos);
+        f.pos = base + len;
+        // the window is unmapped by the release callback even if linking fails
+        await(pipe.WriteExternal, f.data, Delegate<void, Span>(Unmap), f.timeout);
+    }
+
+    async_return(f.end - f.start);
+}
+async_end
+
+void MappedFileSource::Unmap(void* unused, Span data)
+{
+    auto base = uintptr_t(data.Pointer()) & ~uintptr_t(s_pageSize - 1);
+    munmap((void*)base, uintptr_t(data.Pointer()) - base + data.Length());
+}
+
+}
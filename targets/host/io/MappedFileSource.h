@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/MappedFileSource.h
+ *
+ * Feeds a memory-mapped file into a pipe without copying, the mapped pages
+ * are linked as read-only segments
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeWriter.h>
+
+#ifndef MAPPED_FILE_WINDOW
+// default size of a single mapping, rounded down to whole pages
+#define MAPPED_FILE_WINDOW  (1024 * 1024)
+#endif
+
+namespace io
+{
+
+class MappedFileSource
+{
+public:
+    //! Prepares mapping of the file, the descriptor is not closed by the source
+    MappedFileSource(int fd, size_t window = MAPPED_FILE_WINDOW);
+
+    //! Checks if the descriptor refers to a file that can be mapped
+    bool IsValid() const { return size >= 0; }
+    //! Gets the size of the file at the time the source was created
+    int64_t Size() const { return size; }
+
+    //! Links the specified range of the file into the pipe, one window at a time
+    //! Each window is unmapped once all its segments are released by the reader, the pipe is not closed
+    //! @returns the number of bytes linked, the range is clipped at the end of file
+    async(WriteTo, PipeWriter pipe, uint64_t offset = 0, uint64_t length = ~uint64_t(0), Timeout timeout = Timeout::Infinite);
+
+private:
+    int fd;
+    int64_t size = -1;
+    size_t window;
+
+    static void Unmap(void* unused, Span data);
+};
+
+}
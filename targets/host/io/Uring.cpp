@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/Uring.cpp
+ *
+ * The ring is driven by raw system calls, so there is no dependency on liburing
+ */
+
+#ifdef __linux__
+
+#include "Uring.h"
+
+#include <base/MemPoolAsync.h>
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace io
+{
+
+Uring::Uring(unsigned depth)
+{
+    io_uring_params p = {};
+    if ((fd = syscall(__NR_io_uring_setup, depth, &p)) < 0)
+    {
+        return;
+    }
+
+    sqRingSize = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+    cqRingSize = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+    sqesSize = p.sq_entries * sizeof(io_uring_sqe);
+    bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+    if (single)
+    {
+        sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+    }
+
+    void* sq = mmap(NULL, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    void* cq = single ? sq : mmap(NULL, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+    void* e = mmap(NULL, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (sq == MAP_FAILED || cq == MAP_FAILED || e == MAP_FAILED)
+    {
+        if (sq != MAP_FAILED) munmap(sq, sqRingSize);
+        if (!single && cq != MAP_FAILED) munmap(cq, cqRingSize);
+        if (e != MAP_FAILED) munmap(e, sqesSize);
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    sqRing = sq;
+    cqRing = single ? NULL : cq;
+    sqHead = (unsigned*)((char*)sq + p.sq_off.head);
+    sqTail = (unsigned*)((char*)sq + p.sq_off.tail);
+    sqArray = (unsigned*)((char*)sq + p.sq_off.array);
+    sqMask = *(unsigned*)((char*)sq + p.sq_off.ring_mask);
+    sqEntries = p.sq_entries;
+    sqes = (io_uring_sqe*)e;
+    cqHead = (unsigned*)((char*)cq + p.cq_off.head);
+    cqTail = (unsigned*)((char*)cq + p.cq_off.tail);
+    cqMask = *(unsigned*)((char*)cq + p.cq_off.ring_mask);
+    cqEntries = p.cq_entries;
+    cqes = (io_uring_cqe*)((char*)cq + p.cq_off.cqes);
+
+    // the ring descriptor becomes readable when completions are posted
+    watch.fd = fd;
+    watch.events = EPOLLIN;
+    watch.ready = 0;
+    watch.callback = OnReady;
+    watch.ring = this;
+    __platform_watch_fd(&watch);
+}
+
+Uring::~Uring()
+{
+    if (fd < 0)
+    {
+        return;
+    }
+
+    ASSERT(!inflight);
+    __platform_unwatch_fd(&watch);
+    munmap(sqes, sqesSize);
+    munmap(sqRing, sqRingSize);
+    if (cqRing)
+    {
+        munmap(cqRing, cqRingSize);
+    }
+    close(fd);
+}
+
+bool Uring::RegisterBuffer(Buffer region)
+{
+    if (fd < 0 || fixed.Length())
+    {
+        return false;
+    }
+
+    iovec iov = { region.Pointer(), region.Length() };
+    if (syscall(__NR_io_uring_register, fd, IORING_REGISTER_BUFFERS, &iov, 1) < 0)
+    {
+        return false;
+    }
+
+    fixed = region;
+    return true;
+}
+
+bool Uring::Prepare(bool write, int file, const void* data, size_t length, uint64_t offset, Request* req)
+{
+    if (fd < 0 || inflight >= cqEntries)
+    {
+        return false;
+    }
+
+    unsigned tail = *sqTail;
+    if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+    {
+        // make room by handing the queued requests over to the kernel
+        Submit();
+        if (tail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+        {
+            return false;
+        }
+    }
+
+    unsigned index = tail & sqMask;
+    auto sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    bool isFixed = fixed.Contains(Span(data, length));
+    sqe->opcode = write ? (isFixed ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE) : (isFixed ? IORING_OP_READ_FIXED : IORING_OP_READ);
+    sqe->fd = file;
+    sqe->off = offset;
+    sqe->addr = uintptr_t(data);
+    sqe->len = length;
+    sqe->user_data = uintptr_t(req);
+    sqArray[index] = index;
+    req->result = 0;
+    req->done = false;
+
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+    queued++;
+    inflight++;
+    return true;
+}
+
+void Uring::Submit()
+{
+    while (queued)
+    {
+        int res = syscall(__NR_io_uring_enter, fd, queued, 0, 0, NULL, 0);
+        if (res < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            // requests remain queued, they are retried with the next submission
+            break;
+        }
+        queued -= res;
+    }
+}
+
+void Uring::Reap()
+{
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    while (head != tail)
+    {
+        auto cqe = &cqes[head & cqMask];
+        auto req = (Request*)uintptr_t(cqe->user_data);
+        req->result = cqe->res;
+        req->done = true;
+        inflight--;
+        head++;
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    watch.ready = 0;
+}
+
+async(Uring::Complete, Request& req)
+async_def()
+{
+    Submit();
+    Reap();
+    await_signal(req.done);
+    if (req.result < 0)
+    {
+        async_throw(IOError, req.result);
+    }
+    async_return(req.result);
+}
+async_end
+
+async(Uring::ReadToPipe, int file, PipeWriter pipe, uint64_t offset, size_t blockSize)
+async_def(
+    Request req[URING_STREAM_DEPTH];
+    uint64_t offsets[URING_STREAM_DEPTH];
+    size_t lengths[URING_STREAM_DEPTH];
+    unsigned head, count;
+    PipePosition pos;
+    uint64_t offset;
+    size_t total;
+    bool eof;
+    AsyncCatchResult error;
+)
+{
+    f.pos = pipe.Position();
+    f.offset = offset;
+
+    for (;;)
+    {
+        // keep as many reads in flight as there are allocated buffers
+        while (!f.eof && f.count < URING_STREAM_DEPTH)
+        {
+            auto buf = pipe.GetBufferAt(f.pos).Left(blockSize);
+            if (!buf.Length())
+            {
+                if (f.count && !pipe.CanAllocate())
+                {
+                    // throttled, wait for the reader to catch up
+                    break;
+                }
+
+                // allocation must not throw while reads are in flight
+                f.error = await_catch(pipe.Allocate, blockSize);
+                if (!f.error.Success())
+                {
+                    f.eof = true;
+                    break;
+                }
+                continue;
+            }
+
+            unsigned slot = (f.head + f.count) % URING_STREAM_DEPTH;
+            if (!PrepareRead(file, buf, f.offset, &f.req[slot]))
+            {
+                break;
+            }
+            f.offsets[slot] = f.offset;
+            f.lengths[slot] = buf.Length();
+            f.pos += buf.Length();
+            f.offset += buf.Length();
+            f.count++;
+        }
+
+        Submit();
+
+        if (!f.count)
+        {
+            break;
+        }
+
+        // completions are consumed in order, as the data must appear in the pipe sequentially
+        Reap();
+        await_signal(f.req[f.head].done);
+
+        int32_t res = f.req[f.head].result;
+        if (res < 0 && f.error.Success())
+        {
+            f.error = _ASYNC_RES(res, ::kernel::ExceptionType(IOError));
+        }
+
+        if (res > 0 && f.error.Success())
+        {
+            pipe.Advance(res);
+            f.total += res;
+        }
+
+        if (res > 0 && size_t(res) == f.lengths[f.head] && f.error.Success())
+        {
+            f.head = (f.head + 1) % URING_STREAM_DEPTH;
+            f.count--;
+            continue;
+        }
+
+        // end of file, short read or failure - the following reads have landed at wrong positions
+        f.offset = f.offsets[f.head] + std::max(res, 0);
+        f.eof = res <= 0 || !f.error.Success();
+        while (f.count)
+        {
+            await_signal(f.req[f.head].done);
+            f.head = (f.head + 1) % URING_STREAM_DEPTH;
+            f.count--;
+        }
+        f.pos = pipe.Position();
+    }
+
+    async_rethrow(f.error);
+    async_return(f.total);
+}
+async_end
+
+async(Uring::WriteFromPipe, int file, PipeReader pipe, uint64_t offset)
+async_def(
+    Request req[URING_STREAM_DEPTH];
+    uint64_t offsets[URING_STREAM_DEPTH];
+    size_t lengths[URING_STREAM_DEPTH];
+    unsigned head, count;
+    PipePosition pos;
+    uint64_t offset;
+    size_t total;
+    int32_t res;
+)
+{
+    f.pos = pipe.Position();
+    f.offset = offset;
+
+    for (;;)
+    {
+        // write out every readable segment, one request each
+        while (f.count < URING_STREAM_DEPTH)
+        {
+            auto span = pipe.GetSpanAt(f.pos);
+            if (!span.Length())
+            {
+                break;
+            }
+
+            unsigned slot = (f.head + f.count) % URING_STREAM_DEPTH;
+            if (!PrepareWrite(file, span, f.offset, &f.req[slot]))
+            {
+                break;
+            }
+            f.offsets[slot] = f.offset;
+            f.lengths[slot] = span.Length();
+            f.pos += span.Length();
+            f.offset += span.Length();
+            f.count++;
+        }
+
+        Submit();
+
+        if (!f.count)
+        {
+            if (pipe.IsComplete())
+            {
+                break;
+            }
+            await(pipe.Change);
+            continue;
+        }
+
+        Reap();
+        await_signal(f.req[f.head].done);
+
+        f.res = f.req[f.head].result;
+        if (f.res > 0)
+        {
+            pipe.Advance(f.res);
+            f.total += f.res;
+        }
+
+        if (f.res > 0 && size_t(f.res) == f.lengths[f.head])
+        {
+            f.head = (f.head + 1) % URING_STREAM_DEPTH;
+            f.count--;
+            continue;
+        }
+
+        // short write or failure, the requests in flight must complete before retrying or giving up
+        f.offset = f.offsets[f.head] + std::max(f.res, 0);
+        while (f.count)
+        {
+            await_signal(f.req[f.head].done);
+            f.head = (f.head + 1) % URING_STREAM_DEPTH;
+            f.count--;
+        }
+        f.pos = pipe.Position();
+
+        if (f.res <= 0)
+        {
+            async_throw(IOError, f.res);
+        }
+    }
+
+    async_return(f.total);
+}
+async_end
+
+class UringBufferPool::Segment : public PipeSegment
+{
+public:
+    Segment(UringBufferPool& pool, size_t index)
+        : PipeSegment((const uint8_t*)pool.region + index * pool.blockSize, pool.blockSize), pool(pool), index(index)
+    {
+    }
+
+private:
+    UringBufferPool& pool;
+    uint16_t index;
+
+    virtual void Destroy()
+    {
+        auto& pool = this->pool;
+        pool.freeList[pool.freeCount++] = index;
+        pool.released++;
+        MemPoolFree<Segment>(this);
+    }
+};
+
+UringBufferPool::UringBufferPool(Uring& ring, size_t blockSize, size_t blocks)
+    : blockSize(std::min(blockSize, size_t(UINT16_MAX) & ~size_t(4095))), blocks(blocks), freeCount(blocks)
+{
+    ASSERT(blocks <= UINT16_MAX);
+    void* mem = mmap(NULL, this->blockSize * blocks, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED)
+    {
+        // the pool stays empty, allocations fail right away
+        region = NULL;
+        freeList = NULL;
+        this->blocks = freeCount = 0;
+        return;
+    }
+
+    region = (char*)mem;
+    freeList = new uint16_t[blocks];
+    for (size_t i = 0; i < blocks; i++)
+    {
+        freeList[i] = blocks - 1 - i;
+    }
+    // if registration fails, the ring just uses regular reads and writes
+    ring.RegisterBuffer(Buffer(region, this->blockSize * blocks));
+}
+
+UringBufferPool::~UringBufferPool()
+{
+    ASSERT(freeCount == blocks);
+    if (region)
+    {
+        munmap(region, blockSize * blocks);
+        delete[] freeList;
+    }
+}
+
+async(UringBufferPool::AllocateSegment, size_t hint, Timeout timeout)
+async_def(
+    Timeout timeout;
+)
+{
+    if (!region)
+    {
+        async_throw(IOError, -ENOMEM);
+    }
+
+    f.timeout = timeout.MakeAbsolute();
+
+    for (;;)
+    {
+        if (freeCount)
+        {
+            if (auto mem = MemPoolAlloc<Segment>())
+            {
+                async_return(intptr_t(new(mem) Segment(*this, freeList[--freeCount])));
+            }
+            if (!await_mempool_timeout(Segment, f.timeout))
+            {
+                break;
+            }
+        }
+        else if (!await_mask_not_timeout(released, ~0u, released, f.timeout))
+        {
+            break;
+        }
+    }
+
+    async_throw(TimeoutError, 0);
+}
+async_end
+
+}
+
+#endif
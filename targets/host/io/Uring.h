@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/Uring.h
+ *
+ * Linux io_uring completion backend for streaming regular files through
+ * pipes, completions are reaped from the platform sleep path
+ */
+
+#pragma once
+
+#include <kernel/kernel.h>
+
+#include <io/PipeReader.h>
+#include <io/PipeWriter.h>
+
+#ifndef URING_QUEUE_DEPTH
+// default number of submission queue entries of a ring
+#define URING_QUEUE_DEPTH   32
+#endif
+
+#ifndef URING_STREAM_DEPTH
+// maximum number of requests kept in flight by a single ReadToPipe/WriteFromPipe operation
+#define URING_STREAM_DEPTH  8
+#endif
+
+#ifndef URING_BLOCK_SIZE
+// default size of the blocks read by ReadToPipe, the pipe allocator may provide less
+#define URING_BLOCK_SIZE    16384
+#endif
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+namespace io
+{
+
+class Uring
+{
+public:
+    //! Completion slot of a single request
+    struct Request
+    {
+        int32_t result;     //!< Number of bytes transferred or negated errno
+        bool done;          //!< Set when the completion is reaped
+    };
+
+    Uring(unsigned depth = URING_QUEUE_DEPTH);
+    ~Uring();
+
+    //! Checks if the ring has been set up successfully (io_uring may be unavailable or disabled)
+    bool IsValid() const { return fd >= 0; }
+    //! Registers a memory region with the kernel, reads and writes inside it then use the fixed-buffer operations
+    bool RegisterBuffer(Buffer region);
+    //! Gets the registered region
+    Buffer RegisteredBuffer() const { return fixed; }
+
+    //! Queues a read request, the request must stay valid until it is done
+    bool PrepareRead(int file, Buffer buffer, uint64_t offset, Request* req) { return Prepare(false, file, buffer.Pointer(), buffer.Length(), offset, req); }
+    //! Queues a write request, the request must stay valid until it is done
+    bool PrepareWrite(int file, Span data, uint64_t offset, Request* req) { return Prepare(true, file, data.Pointer(), data.Length(), offset, req); }
+    //! Submits all queued requests to the kernel in one call
+    void Submit();
+    //! Collects all available completions
+    void Reap();
+    //! Waits for the request to complete, throws IOError with the negated errno on failure
+    async(Complete, Request& req);
+
+    //! Reads the file starting at the specified offset into the pipe until end of file is reached, keeping multiple reads in flight
+    //! @returns the number of bytes read, the pipe is not closed
+    async(ReadToPipe, int file, PipeWriter pipe, uint64_t offset = 0, size_t blockSize = URING_BLOCK_SIZE);
+    //! Writes all data from the pipe to the file starting at the specified offset, until the pipe is completed
+    //! @returns the number of bytes written
+    async(WriteFromPipe, int file, PipeReader pipe, uint64_t offset = 0);
+
+private:
+    struct Watch : __platform_fd_watch
+    {
+        Uring* ring;
+    };
+
+    int fd = -1;
+    unsigned inflight = 0, queued = 0;
+    Watch watch;
+    Buffer fixed;
+
+    void* sqRing = NULL;
+    void* cqRing = NULL;
+    size_t sqRingSize, cqRingSize, sqesSize;
+    unsigned *sqHead, *sqTail, *sqArray, sqMask, sqEntries;
+    unsigned *cqHead, *cqTail, cqMask, cqEntries;
+    io_uring_sqe* sqes = NULL;
+    io_uring_cqe* cqes;
+
+    bool Prepare(bool write, int file, const void* data, size_t length, uint64_t offset, Request* req);
+    static void OnReady(__platform_fd_watch* watch) { ((Watch*)watch)->ring->Reap(); }
+};
+
+//! Pipe allocator handing out segments carved from a memory region registered with a ring,
+//! so the reads and writes of the ring can use fixed buffers
+class UringBufferPool : public PipeAllocator
+{
+public:
+    UringBufferPool(Uring& ring, size_t blockSize = URING_BLOCK_SIZE, size_t blocks = URING_QUEUE_DEPTH);
+    ~UringBufferPool();
+
+    //! Checks if the buffer region has been mapped, allocations from an invalid pool throw IOError
+    bool IsValid() const { return region; }
+    size_t BlockSize() const { return blockSize; }
+
+    virtual async(AllocateSegment, size_t hint, Timeout timeout);
+
+private:
+    class Segment;
+
+    char* region;
+    size_t blockSize, blocks;
+    uint16_t* freeList;
+    size_t freeCount;
+    uint32_t released = 0;      //!< Incremented every time a block is returned, for waiting allocations
+
+    friend class Segment;
+};
+
+}
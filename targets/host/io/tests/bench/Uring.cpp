@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/tests/bench/Uring.cpp
+ *
+ * Compares copying a file through a pipe using io_uring against plain
+ * read/write calls
+ *
+ * Each case adds a row to the result table, with the throughput in MB/s
+ * (not milliseconds) in the duration column
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+#include <io/Uring.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+// size of the copied file
+constexpr size_t Length = 16 << 20;
+// number of times the file is copied
+constexpr size_t Rounds = 4;
+
+int CreateFile(bool fill)
+{
+    char name[] = "/tmp/uringXXXXXX";
+    int fd = mkstemp(name);
+    unlink(name);
+    if (fill)
+    {
+        static char buf[65536];
+        memset(buf, 0x55, sizeof(buf));
+        for (size_t off = 0; off < Length; off += sizeof(buf))
+        {
+            UNUSED auto res = write(fd, buf, sizeof(buf));
+        }
+    }
+    return fd;
+}
+
+struct Plain
+{
+    static async(Read, int fd, PipeWriter w, size_t blockSize)
+    async_def()
+    {
+        for (;;)
+        {
+            await(w.Allocate, blockSize);
+            auto buf = w.GetBuffer().Left(blockSize);
+            auto res = read(fd, buf.Pointer(), buf.Length());
+            if (res <= 0)
+            {
+                break;
+            }
+            w.Advance(res);
+        }
+        w.Close();
+    }
+    async_end
+
+    static async(Write, int fd, PipeReader r)
+    async_def()
+    {
+        while (await(r.Require))
+        {
+            auto span = r.GetSpan();
+            auto res = write(fd, span.Pointer(), span.Length());
+            if (res <= 0)
+            {
+                break;
+            }
+            r.Advance(res);
+        }
+    }
+    async_end
+};
+
+struct Ring
+{
+    static async(Read, Uring* ring, int fd, PipeWriter w, size_t blockSize)
+    async_def()
+    {
+        await(ring->ReadToPipe, fd, w, 0, blockSize);
+        w.Close();
+    }
+    async_end
+
+    static async(Write, Uring* ring, int fd, PipeReader r)
+    async_def()
+    {
+        await(ring->WriteFromPipe, fd, r);
+    }
+    async_end
+};
+
+template<typename TCopy> uint32_t Measure(TCopy copy)
+{
+    int src = CreateFile(true);
+    int dst = CreateFile(false);
+    auto t0 = MONO_US;
+    for (size_t r = 0; r < Rounds; r++)
+    {
+        copy(src, dst);
+    }
+    auto t = MONO_US - t0;
+    AssertEqual(size_t(lseek(dst, 0, SEEK_END)), Length);
+    close(src);
+    close(dst);
+    return t;
+}
+
+void BenchPlain(const char* what, PipeAllocator* allocator, size_t blockSize)
+{
+    TestCase::ReportThroughput(uint64_t(Length) * Rounds, Measure([&](int src, int dst)
+    {
+        Scheduler s;
+        // NULL selects the default allocator
+        auto p = allocator ? new Pipe(*allocator) : new Pipe();
+        p->ThrottleLevel(blockSize * URING_STREAM_DEPTH);
+        lseek(src, 0, SEEK_SET);
+        lseek(dst, 0, SEEK_SET);
+        s.Add(&Plain::Read, src, *p, blockSize);
+        s.Add(&Plain::Write, dst, *p);
+        s.Run();
+        delete p;
+    }), "%s %u B blocks", what, unsigned(blockSize));
+}
+
+void BenchRing(const char* what, Uring& ring, PipeAllocator* allocator, size_t blockSize)
+{
+    TestCase::ReportThroughput(uint64_t(Length) * Rounds, Measure([&](int src, int dst)
+    {
+        Scheduler s;
+        // NULL selects the default allocator
+        auto p = allocator ? new Pipe(*allocator) : new Pipe();
+        p->ThrottleLevel(blockSize * URING_STREAM_DEPTH);
+        s.Add(&Ring::Read, &ring, src, *p, blockSize);
+        s.Add(&Ring::Write, &ring, dst, *p);
+        s.Run();
+        delete p;
+    }), "%s %u B blocks", what, unsigned(blockSize));
+}
+
+TEST_CASE("01 Default allocator")
+{
+    // allocating ahead of every read keeps segments of the default allocator at the block size
+    BenchPlain("read/write", NULL, 1024);
+
+    Uring ring;
+    if (ring.IsValid())
+    {
+        BenchRing("io_uring", ring, NULL, 1024);
+    }
+}
+
+TEST_CASE("02 Registered buffers")
+{
+    for (size_t blockSize: { 4096, 16384, 61440 })
+    {
+        Uring ring;
+        if (!ring.IsValid())
+        {
+            return;
+        }
+
+        // the same page-aligned blocks are used by both, only the transfer differs
+        UringBufferPool pool(ring, blockSize, URING_STREAM_DEPTH * 2);
+        BenchPlain("read/write", &pool, blockSize);
+        BenchRing("io_uring fixed", ring, &pool, blockSize);
+    }
+}
+
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/tests/fd/Fd.cpp
+ *
+ * Tests pumping pipes through file descriptors
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+#include <io/FdReceiver.h>
+#include <io/FdTransmitter.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+constexpr size_t Length = 200000;
+
+TEST_CASE("01 Socket Pair")
+{
+    // the receiver and transmitter run helper tasks on the main scheduler
+    auto& s = Scheduler::Main();
+    Pipe src, dst;
+
+    int fds[2];
+    AssertEqual(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    FdTransmitter tx(fds[0]);
+    FdReceiver rx(fds[1]);
+
+    struct S
+    {
+        static async(Writer, PipeWriter w)
+        async_def(
+            size_t written;
+            char buf[1000];
+        )
+        {
+            while (f.written < Length)
+            {
+                for (size_t i = 0; i < sizeof(f.buf); i++)
+                {
+                    f.buf[i] = char((f.written + i) * 13);
+                }
+                await(w.Write, Span(f.buf, sizeof(f.buf)));
+                f.written += sizeof(f.buf);
+            }
+            w.Close();
+        }
+        async_end
+
+        static async(Transmit, FdTransmitter* tx, PipeReader r, int fd)
+        async_def()
+        {
+            await(tx->TransmitFromPipe, r);
+            // the receiving side gets an end of stream
+            shutdown(fd, SHUT_WR);
+        }
+        async_end
+
+        static async(Reader, PipeReader r)
+        async_def(
+            size_t read;
+        )
+        {
+            while (await(r.Require))
+            {
+                for (char c: r.GetSpan())
+                {
+                    AssertEqual(c, char(f.read++ * 13));
+                }
+                r.Advance(r.GetSpan().Length());
+            }
+            AssertEqual(f.read, Length);
+            Assert(r.IsComplete());
+        }
+        async_end
+    };
+
+    s.Add(&S::Writer, src);
+    s.Add(&S::Transmit, &tx, src, fds[0]);
+    rx.StartReceiveToPipe(dst, 1024);
+    s.Add(&S::Reader, dst);
+    s.Run();
+
+    Assert(src.IsCompleted());
+    Assert(dst.IsCompleted());
+    AssertEqual(tx.Error(), 0);
+    AssertEqual(rx.Error(), 0);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/tests/mapped/MappedFile.cpp
+ *
+ * Tests linking memory-mapped files into pipes
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+#include <io/MappedFileSource.h>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+constexpr size_t Length = 300001;
+constexpr size_t Window = 65536;
+
+int CreateFile()
+{
+    char name[] = "/tmp/mappedXXXXXX";
+    int fd = mkstemp(name);
+    unlink(name);
+    char buf[4096];
+    for (size_t off = 0; off < Length; off += sizeof(buf))
+    {
+        for (size_t i = 0; i < sizeof(buf); i++)
+        {
+            buf[i] = char((off + i) * 7);
+        }
+        UNUSED auto res = write(fd, buf, std::min(sizeof(buf), Length - off));
+    }
+    return fd;
+}
+
+bool IsMapped(const void* p)
+{
+    auto page = uintptr_t(p) & ~uintptr_t(sysconf(_SC_PAGESIZE) - 1);
+    return msync((void*)page, 1, MS_ASYNC) == 0 || errno != ENOMEM;
+}
+
+struct S
+{
+    static async(Write, MappedFileSource* src, PipeWriter w, uint64_t offset, uint64_t length, size_t expect)
+    async_def()
+    {
+        AssertEqual(size_t(await(src->WriteTo, w, offset, length)), expect);
+        w.Close();
+    }
+    async_end
+
+    static async(Verify, PipeReader r, size_t offset, size_t length, const void** first)
+    async_def(
+        size_t read;
+    )
+    {
+        while (await(r.Require))
+        {
+            auto span = r.GetSpan();
+            if (!f.read)
+            {
+                *first = span.Pointer();
+                Assert(IsMapped(span.Pointer()));
+            }
+            for (char c: span)
+            {
+                AssertEqual(c, char((offset + f.read++) * 7));
+            }
+            r.Advance(span.Length());
+        }
+        AssertEqual(f.read, length);
+    }
+    async_end
+};
+
+void Copy(uint64_t offset, uint64_t length, size_t expect)
+{
+    Scheduler s;
+    int fd = CreateFile();
+    MappedFileSource src(fd, Window);
+    Assert(src.IsValid());
+    AssertEqual(src.Size(), int64_t(Length));
+
+    Pipe p;
+    p.ThrottleLevel(Window);
+    const void* first = NULL;
+    s.Add(&S::Write, &src, p, offset, length, expect);
+    s.Add(&S::Verify, p, offset, expect, &first);
+    s.Run();
+    Assert(p.IsCompleted());
+
+    // all windows have been released by the reader
+    Assert(first);
+    Assert(!IsMapped(first));
+    close(fd);
+}
+
+TEST_CASE("01 Whole File")
+{
+    Copy(0, ~uint64_t(0), Length);
+}
+
+TEST_CASE("02 Range")
+{
+    // unaligned start spanning several windows
+    Copy(5000, 200000, 200000);
+    // clipped at the end of file
+    Copy(Length - 1000, 5000, 1000);
+}
+
+TEST_CASE("03 Invalid")
+{
+    int fds[2];
+    AssertEqual(pipe(fds), 0);
+    MappedFileSource src(fds[0]);
+    Assert(!src.IsValid());
+    close(fds[0]);
+    close(fds[1]);
+}
+
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026 triaxis s.r.o.
+ * Licensed under the MIT license. See LICENSE.txt file in the repository root
+ * for full license information.
+ *
+ * targets/host/io/tests/uring/Uring.cpp
+ *
+ * Tests streaming files through pipes using io_uring
+ */
+
+#include <testrunner/TestCase.h>
+
+#include <kernel/kernel.h>
+#include <io/io.h>
+#include <io/Uring.h>
+
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+namespace
+{
+
+using namespace io;
+using namespace kernel;
+
+constexpr size_t Length = 300001;
+
+int CreateFile(bool fill)
+{
+    char name[] = "/tmp/uringXXXXXX";
+    int fd = mkstemp(name);
+    unlink(name);
+    if (fill)
+    {
+        char buf[4096];
+        for (size_t off = 0; off < Length; off += sizeof(buf))
+        {
+            for (size_t i = 0; i < sizeof(buf); i++)
+            {
+                buf[i] = char((off + i) * 7);
+            }
+            UNUSED auto res = write(fd, buf, std::min(sizeof(buf), Length - off));
+        }
+    }
+    return fd;
+}
+
+struct S
+{
+    static async(Read, Uring* ring, int fd, PipeWriter w)
+    async_def()
+    {
+        AssertEqual(size_t(await(ring->ReadToPipe, fd, w)), Length);
+        w.Close();
+    }
+    async_end
+
+    static async(Write, Uring* ring, int fd, PipeReader r)
+    async_def()
+    {
+        AssertEqual(size_t(await(ring->WriteFromPipe, fd, r)), Length);
+    }
+    async_end
+
+    static async(Verify, PipeReader r)
+    async_def(
+        size_t read;
+    )
+    {
+        while (await(r.Require))
+        {
+            for (char c: r.GetSpan())
+            {
+                AssertEqual(c, char(f.read++ * 7));
+            }
+            r.Advance(r.GetSpan().Length());
+        }
+        AssertEqual(f.read, Length);
+    }
+    async_end
+};
+
+void Copy(Uring& ring, Pipe& p)
+{
+    Scheduler s;
+    int src = CreateFile(true);
+    int dst = CreateFile(false);
+
+    s.Add(&S::Read, &ring, src, p);
+    s.Add(&S::Write, &ring, dst, p);
+    s.Run();
+    Assert(p.IsCompleted());
+
+    // the copy must be identical
+    Pipe check;
+    s.Add(&S::Read, &ring, dst, check);
+    s.Add(&S::Verify, check);
+    s.Run();
+    Assert(check.IsCompleted());
+
+    close(src);
+    close(dst);
+}
+
+TEST_CASE("01 Copy File")
+{
+    Uring ring;
+    if (!ring.IsValid())
+    {
+        // io_uring not available on this system
+        return;
+    }
+
+    Pipe p;
+    p.ThrottleLevel(URING_BLOCK_SIZE);
+    Copy(ring, p);
+}
+
+TEST_CASE("02 Copy File Registered Buffers")
+{
+    Uring ring;
+    if (!ring.IsValid())
+    {
+        return;
+    }
+
+    UringBufferPool pool(ring, 8192, 16);
+    AssertEqual(ring.RegisteredBuffer().Length(), 8192u * 16);
+
+    Pipe p(pool);
+    p.ThrottleLevel(8192 * 8);
+    Copy(ring, p);
+}
+
+}